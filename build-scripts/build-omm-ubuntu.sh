@@ -80,7 +80,7 @@ case "$dist" in
   ;;
 esac
 
-sudo apt install -y libpoppler-qt5-dev libkf5itemmodels-dev
+sudo apt install -y libpoppler-qt5-dev libkf5itemmodels-dev libpng-dev
 
 git clone https://gitlab.com/inkscape/lib2geom.git
 pushd lib2geom
@@ -9,8 +9,12 @@
 #include "renderers/style.h"
 #include "scene/stylelist.h"
 #include <list>
+#include <algorithm>
 #include <functional>
 #include "scene/messagebox.h"
+#include "scene/dependencygraph.h"
+#include "objects/object.h"
+#include "common.h"
 #include "mainwindow/application.h"
 #include "animation/channelproxy.h"
 
@@ -43,6 +47,8 @@ Animator::Animator(Scene& scene) : scene(scene), accelerator(*this)
   connect(this, SIGNAL(knot_inserted(Track&, int)), this, SIGNAL(track_changed(Track&)));
   connect(this, SIGNAL(track_inserted(Track&)), this, SIGNAL(track_changed(Track&)));
   connect(this, SIGNAL(track_removed(Track&)), this, SIGNAL(track_changed(Track&)));
+  connect(this, SIGNAL(knot_changed(Track&, int)), this, SIGNAL(track_changed(Track&)));
+  connect(this, SIGNAL(interpolation_changed(Track&)), this, SIGNAL(track_changed(Track&)));
 
   connect(this, &Animator::track_inserted, this, [this](Track& track) {
     for (std::size_t c = 0; c < track.property().n_channels(); c++) {
@@ -55,6 +61,54 @@ Animator::Animator(Scene& scene) : scene(scene), accelerator(*this)
     }
   });
 
+  // == frame cache
+  connect(&scene.message_box(), &MessageBox::property_value_changed, this,
+          [this](AbstractPropertyOwner& owner, const QString&, Property& property)
+  {
+    if (m_tag_values != nullptr) {
+      // clones and other temporary owners must not be recorded.
+      if (::contains(m_tag_value_owners, &owner)) {
+        (*m_tag_values)[&property] = property.variant_value();
+      }
+    } else if (!m_is_applying) {
+      if (owner.kind == Kind::Tag) {
+        // the edit may change the effect of the tag on frames which do not depend on tags yet.
+        invalidate_frame_cache();
+      } else {
+        // tags may read any property.
+        m_frame_cache.invalidate_tag_dependent_frames();
+      }
+    }
+  });
+  connect(&scene.message_box(), qOverload<Object&>(&MessageBox::appearance_changed),
+          this, [this](Object& object)
+  {
+    if (!m_is_applying) {
+      m_frame_cache.invalidate_geometry(object);
+      m_edited_objects.insert(&object);
+    }
+  });
+  connect(&scene.message_box(), &MessageBox::abstract_property_owner_inserted,
+          this, &Animator::invalidate_frame_cache);
+  connect(&scene.message_box(), &MessageBox::abstract_property_owner_removed,
+          this, &Animator::invalidate_frame_cache);
+  connect(&scene.message_box(), &MessageBox::scene_reseted,
+          this, &Animator::invalidate_frame_cache);
+  connect(this, &Animator::track_inserted, this, &Animator::invalidate_frame_cache);
+  connect(this, &Animator::track_removed, this, &Animator::invalidate_frame_cache);
+  connect(this, &Animator::interpolation_changed, this, &Animator::invalidate_frame_cache);
+  for (auto&& signal : { &Animator::knot_inserted, &Animator::knot_removed,
+                         &Animator::knot_changed })
+  {
+    connect(this, signal, this, [this](Track& track, int frame) {
+      m_frame_cache.invalidate_frames(track, frame);
+    });
+  }
+  connect(this, &Animator::knot_moved, this, [this](Track& track, int old_frame, int new_frame) {
+    m_frame_cache.invalidate_frames(track, old_frame);
+    m_frame_cache.invalidate_frames(track, new_frame);
+  });
+
   invalidate();
 }
 
@@ -165,10 +219,140 @@ void Animator::advance(PlayDirection direction)
 
 void Animator::apply()
 {
-  for (Property* property : accelerator().properties()) {
-    property->track()->apply(m_current_frame);
+  m_is_applying = true;
+  m_discard_frame = false;
+  m_edited_objects.clear();
+  if (const FrameCache::Values* values = m_frame_cache.values(m_current_frame); values != nullptr) {
+    apply_cached_values(*values);
+  } else {
+    evaluate_frame();
+  }
+  m_is_applying = false;
+
+  if (!m_discard_frame) {
+    for (const Object* object : m_objects_to_cache) {
+      m_frame_cache.insert_geometry(*object, m_current_frame, object->geom_paths());
+    }
+  }
+  m_objects_to_cache.clear();
+}
+
+void Animator::apply_cached_values(const FrameCache::Values& values)
+{
+  // the values might be evicted while they are applied.
+  const auto copy = values;
+
+  // the tags are not evaluated, the values they have written are part of the cache.
+  const auto batch = scene.dependency_graph().make_batch(true);
+  for (auto&& [property, value] : copy) {
+    property->set(value);
+  }
+}
+
+void Animator::evaluate_frame()
+{
+  {
+    // write all values first, then update each affected object once, in dependency order.
+    const auto batch = scene.dependency_graph().make_batch(true);
+    for (Property* property : accelerator().properties()) {
+      property->track()->apply(m_current_frame);
+    }
+  }
+
+  const auto tags = scene.tags();
+  const auto has_effect = [&tags](Tag::FrameEffect effect) {
+    return std::any_of(tags.begin(), tags.end(), [effect](const Tag* tag) {
+      return tag->frame_effect() == effect;
+    });
+  };
+
+  // the cache cannot replay what python code does besides writing properties,
+  // hence frames where such tags are evaluated are not cached.
+  if (has_effect(Tag::FrameEffect::Arbitrary)) {
+    m_discard_frame = true;
+  }
+
+  FrameCache::Values values;
+  const bool depends_on_tags = has_effect(Tag::FrameEffect::Properties);
+  if (m_frame_cache.is_enabled() && !m_discard_frame) {
+    for (Property* property : accelerator().properties()) {
+      values.insert({ property, property->variant_value() });
+    }
+    if (depends_on_tags) {
+      m_tag_value_owners = scene.property_owners();
+      m_tag_values = &values;
+    }
   }
+
+  // tags may query the geometry of the objects, hence they must be evaluated after the batch.
   scene.evaluate_tags();
+  m_tag_values = nullptr;
+  m_tag_value_owners.clear();
+
+  if (m_frame_cache.is_enabled() && !m_discard_frame) {
+    for (auto&& [property, value] : values) {
+      Q_UNUSED(value)
+      watch(*property);
+    }
+    m_frame_cache.insert_values(m_current_frame, std::move(values), depends_on_tags);
+  }
+}
+
+const Geom::PathVector* Animator::cached_geometry(const Object& object)
+{
+  if (m_frame_cache.caches_geometry()) {
+    return m_frame_cache.geometry(object, m_current_frame);
+  } else {
+    return nullptr;
+  }
+}
+
+void Animator::cache_geometry(const Object& object, const Geom::PathVector& paths)
+{
+  if (!m_frame_cache.caches_geometry()) {
+    return;
+  }
+
+  watch(object);
+  if (m_is_applying) {
+    m_objects_to_cache.insert(&object);
+  } else if (!::contains(m_edited_objects, &object)) {
+    m_frame_cache.insert_geometry(object, m_current_frame, paths);
+  }
+}
+
+void Animator::watch(const QObject& qobject, const std::function<void()>& forget)
+{
+  if (const auto [it, inserted] = m_watched.insert(&qobject); inserted) {
+    Q_UNUSED(it)
+    connect(&qobject, &QObject::destroyed, this, [this, &qobject, forget]() {
+      m_watched.erase(&qobject);
+      forget();
+    });
+  }
+}
+
+void Animator::watch(const Property& property)
+{
+  watch(property, [this, property=&property]() { m_frame_cache.forget(property); });
+}
+
+void Animator::watch(const Object& object)
+{
+  watch(object, [this, object=&object]() {
+    m_frame_cache.forget(object);
+    m_objects_to_cache.erase(object);
+    m_edited_objects.erase(object);
+  });
+}
+
+void Animator::invalidate_frame_cache()
+{
+  m_frame_cache.invalidate();
+  m_objects_to_cache.clear();
+  if (m_is_applying) {
+    m_discard_frame = true;
+  }
 }
 
 void Animator::invalidate()
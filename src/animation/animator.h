@@ -5,10 +5,12 @@
 #include <QTimer>
 #include <set>
 #include <memory>
+#include <functional>
 #include "cachedgetter.h"
 #include <QAbstractItemModel>
 #include "variant.h"
 #include "animation/track.h"
+#include "animation/framecache.h"
 
 namespace omm
 {
@@ -18,6 +20,7 @@ class Track;
 class Scene;
 class Property;
 class ChannelProxy;
+class Object;
 
 class Animator : public QAbstractItemModel, public Serializable
 {
@@ -83,6 +86,12 @@ Q_SIGNALS:
   void knot_removed(Track&, int);
   void knot_moved(Track&, int, int);
 
+  /**
+   * @brief knot_changed is emitted when the value or the offsets of a knot changed.
+   */
+  void knot_changed(Track&, int);
+  void interpolation_changed(Track&);
+
   // == ItemModel
 public:
   enum class IndexType { Owner = 0, Property = 1, Channel = 2, None };
@@ -165,6 +174,47 @@ private:
 
   // === channel pointers
   std::map<std::pair<Track*, std::size_t>, std::unique_ptr<ChannelProxy>> m_channel_proxies;
+
+  // == frame cache
+public:
+  FrameCache& frame_cache() { return m_frame_cache; }
+
+  /**
+   * @brief cached_geometry returns the cached geometry of @code object at the current frame or
+   *  nullptr if there is none.
+   */
+  const Geom::PathVector* cached_geometry(const Object& object);
+
+  /**
+   * @brief cache_geometry caches the geometry of @code object at the current frame.
+   *  The geometry is not cached if @code object has been edited since the frame was applied.
+   *  During `apply`, the geometry may be intermediate. It is cached when `apply` has finished.
+   */
+  void cache_geometry(const Object& object, const Geom::PathVector& paths);
+
+private:
+  FrameCache m_frame_cache;
+  bool m_is_applying = false;
+
+  // the cached values of the current frame are discarded if the cache is invalidated during apply.
+  bool m_discard_frame = false;
+  std::set<const Object*> m_edited_objects;
+  std::set<const Object*> m_objects_to_cache;
+
+  // the values written by tags are recorded while the tags are evaluated in `apply`.
+  FrameCache::Values* m_tag_values = nullptr;
+  std::set<AbstractPropertyOwner*> m_tag_value_owners;
+
+  // the cache is keyed by address, hence the entries of destroyed items must be dropped before
+  // the address is reused.
+  std::set<const QObject*> m_watched;
+  void watch(const QObject& qobject, const std::function<void()>& forget);
+  void watch(const Property& property);
+  void watch(const Object& object);
+
+  void invalidate_frame_cache();
+  void apply_cached_values(const FrameCache::Values& values);
+  void evaluate_frame();
 };
 
 }  // namespace omm
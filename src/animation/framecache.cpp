@@ -0,0 +1,234 @@
+#include "animation/framecache.h"
+#include <limits>
+#include <QSettings>
+#include "animation/track.h"
+#include "2geom/bezier-curve.h"
+
+namespace
+{
+
+// the size of a node of a std::map, roughly.
+constexpr std::size_t MAP_NODE_SIZE = 4 * sizeof(void*);
+
+std::size_t estimate_size(const omm::variant_type& value)
+{
+  return MAP_NODE_SIZE + sizeof(omm::Property*) + sizeof(value);
+}
+
+std::size_t estimate_size(const Geom::PathVector& paths)
+{
+  std::size_t size = MAP_NODE_SIZE + sizeof(omm::Object*) + sizeof(paths);
+  for (const Geom::Path& path : paths) {
+    // most curves of an ommpfritt path are cubic beziers.
+    size += sizeof(path) + (path.size_default() + 1) * sizeof(Geom::CubicBezier);
+  }
+  return size;
+}
+
+}  // namespace
+
+namespace omm
+{
+
+FrameCache::FrameCache()
+{
+  const QSettings settings;
+  set_budget(settings.value(BUDGET_SETTINGS_KEY, 0).toULongLong() * MEBIBYTE);
+  set_caches_geometry(settings.value(CACHES_GEOMETRY_SETTINGS_KEY, true).toBool());
+}
+
+void FrameCache::set_budget(std::size_t budget)
+{
+  m_budget = budget;
+  evict();
+}
+
+void FrameCache::set_caches_geometry(bool caches_geometry)
+{
+  m_caches_geometry = caches_geometry;
+  if (!m_caches_geometry) {
+    for (auto&& [i, frame] : m_frames) {
+      Q_UNUSED(i)
+      std::size_t size = frame.size;
+      for (auto&& [object, paths] : frame.geometry) {
+        Q_UNUSED(object)
+        size -= estimate_size(paths);
+      }
+      frame.geometry.clear();
+      resize(frame, size);
+    }
+  }
+}
+
+const FrameCache::Values* FrameCache::values(int frame)
+{
+  if (const auto it = m_frames.find(frame); it != m_frames.end() && it->second.values) {
+    return &*use(frame).values;
+  } else {
+    return nullptr;
+  }
+}
+
+void FrameCache::insert_values(int i, Values values, bool depends_on_tags)
+{
+  if (!is_enabled()) {
+    return;
+  }
+
+  Frame& frame = use(i);
+  std::size_t size = frame.size;
+  if (frame.values) {
+    for (auto&& [property, value] : *frame.values) {
+      Q_UNUSED(property)
+      size -= estimate_size(value);
+    }
+  }
+  for (auto&& [property, value] : values) {
+    Q_UNUSED(property)
+    size += estimate_size(value);
+  }
+  frame.values = std::move(values);
+  frame.depends_on_tags = depends_on_tags;
+  resize(frame, size);
+  evict();
+}
+
+const Geom::PathVector* FrameCache::geometry(const Object& object, int frame)
+{
+  if (const auto it = m_frames.find(frame); it != m_frames.end()) {
+    if (const auto git = it->second.geometry.find(&object); git != it->second.geometry.end()) {
+      use(frame);
+      return &git->second;
+    }
+  }
+  return nullptr;
+}
+
+void FrameCache::insert_geometry(const Object& object, int i, const Geom::PathVector& paths)
+{
+  if (!caches_geometry()) {
+    return;
+  }
+
+  Frame& frame = use(i);
+  std::size_t size = frame.size;
+  if (const auto it = frame.geometry.find(&object); it != frame.geometry.end()) {
+    size -= estimate_size(it->second);
+    frame.geometry.erase(it);
+  }
+  frame.geometry.insert({ &object, paths });
+  resize(frame, size + estimate_size(paths));
+  evict();
+}
+
+void FrameCache::invalidate()
+{
+  m_frames.clear();
+  m_lru.clear();
+  m_size = 0;
+}
+
+void FrameCache::invalidate_frames(int first, int last)
+{
+  for (auto it = m_frames.lower_bound(first); it != m_frames.end() && it->first <= last;) {
+    erase(it++);
+  }
+}
+
+void FrameCache::invalidate_frames(const Track& track, int frame)
+{
+  // the knot affects all frames between its neighbors.
+  // If it is the first or last knot, it also affects all frames before or after it, respectively.
+  int first = std::numeric_limits<int>::min();
+  int last = std::numeric_limits<int>::max();
+  for (const int key_frame : track.key_frames()) {
+    if (key_frame < frame) {
+      first = key_frame + 1;
+    } else if (key_frame > frame) {
+      last = key_frame - 1;
+      break;
+    }
+  }
+  invalidate_frames(first, last);
+}
+
+void FrameCache::invalidate_tag_dependent_frames()
+{
+  for (auto it = m_frames.begin(); it != m_frames.end();) {
+    if (it->second.depends_on_tags) {
+      erase(it++);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void FrameCache::invalidate_geometry(const Object& object)
+{
+  forget(&object);
+}
+
+void FrameCache::forget(const Property* property)
+{
+  for (auto&& [i, frame] : m_frames) {
+    Q_UNUSED(i)
+    if (!frame.values) {
+      continue;
+    }
+    // `Values` is keyed by non-const pointers.
+    if (const auto it = frame.values->find(const_cast<Property*>(property));
+        it != frame.values->end())
+    {
+      const std::size_t size = frame.size - estimate_size(it->second);
+      frame.values->erase(it);
+      resize(frame, size);
+    }
+  }
+}
+
+void FrameCache::forget(const Object* object)
+{
+  for (auto&& [i, frame] : m_frames) {
+    Q_UNUSED(i)
+    if (const auto it = frame.geometry.find(object); it != frame.geometry.end()) {
+      const std::size_t size = frame.size - estimate_size(it->second);
+      frame.geometry.erase(it);
+      resize(frame, size);
+    }
+  }
+}
+
+FrameCache::Frame& FrameCache::use(int i)
+{
+  auto [it, inserted] = m_frames.try_emplace(i);
+  Frame& frame = it->second;
+  if (inserted) {
+    m_lru.push_front(i);
+  } else {
+    m_lru.splice(m_lru.begin(), m_lru, frame.lru_position);
+  }
+  frame.lru_position = m_lru.begin();
+  return frame;
+}
+
+void FrameCache::erase(std::map<int, Frame>::iterator it)
+{
+  m_size -= it->second.size;
+  m_lru.erase(it->second.lru_position);
+  m_frames.erase(it);
+}
+
+void FrameCache::resize(Frame& frame, std::size_t new_size)
+{
+  m_size = m_size - frame.size + new_size;
+  frame.size = new_size;
+}
+
+void FrameCache::evict()
+{
+  while (m_size > m_budget && !m_lru.empty()) {
+    erase(m_frames.find(m_lru.back()));
+  }
+}
+
+}  // namespace omm
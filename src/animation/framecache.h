@@ -0,0 +1,129 @@
+#pragma once
+
+#include <list>
+#include <map>
+#include <optional>
+#include "2geom/pathvector.h"
+#include "variant.h"
+
+namespace omm
+{
+
+class Object;
+class Property;
+class Track;
+
+/**
+ * @brief The FrameCache class stores the evaluated state of frames to replay them quickly when
+ *  scrubbing the timeline or looping the playback.
+ *  Per frame, it stores the values of the properties written by the animation, i.e., by the
+ *  tracks and by the tags, and optionally the geometry (`Object::geom_paths`) of the objects.
+ *  The cache is limited by a memory budget. The least recently used frames are dropped first.
+ *  A budget of zero disables the cache.
+ *  The cache does not know when it becomes outdated, the `Animator` invalidates it.
+ */
+class FrameCache
+{
+public:
+  FrameCache();
+
+  // the budget in MiB.
+  static constexpr auto BUDGET_SETTINGS_KEY = "frame_cache/budget";
+  static constexpr std::size_t MEBIBYTE = 1024 * 1024;
+  static constexpr auto CACHES_GEOMETRY_SETTINGS_KEY = "frame_cache/geometry";
+
+  /**
+   * @brief set_budget sets the maximal size of the cache in bytes.
+   *  Frames are dropped immediately if the cache exceeds the new budget.
+   */
+  void set_budget(std::size_t budget);
+  std::size_t budget() const { return m_budget; }
+  bool is_enabled() const { return m_budget > 0; }
+  void set_caches_geometry(bool caches_geometry);
+  bool caches_geometry() const { return is_enabled() && m_caches_geometry; }
+
+  /**
+   * @brief size returns the estimated size of the cache in bytes.
+   */
+  std::size_t size() const { return m_size; }
+
+  using Values = std::map<Property*, variant_type>;
+
+  /**
+   * @brief values returns the values of the given frame or nullptr if they are not cached.
+   */
+  const Values* values(int frame);
+
+  /**
+   * @param depends_on_tags whether @code values contain properties written by tags.
+   *  Tags may read any property, hence such values are invalidated by any edit.
+   */
+  void insert_values(int frame, Values values, bool depends_on_tags);
+
+  /**
+   * @brief geometry returns the geometry of @code object at @code frame or nullptr if it is not
+   *  cached.
+   */
+  const Geom::PathVector* geometry(const Object& object, int frame);
+  void insert_geometry(const Object& object, int frame, const Geom::PathVector& paths);
+
+  void invalidate();
+
+  /**
+   * @brief invalidate_frames drops the frames in the closed interval [@code first, @code last].
+   */
+  void invalidate_frames(int first, int last);
+
+  /**
+   * @brief invalidate_frames drops the frames which are affected if the knot at @code frame of
+   *  @code track is inserted, removed or changed.
+   */
+  void invalidate_frames(const Track& track, int frame);
+
+  /**
+   * @brief invalidate_tag_dependent_frames drops the frames whose values were written by tags.
+   */
+  void invalidate_tag_dependent_frames();
+
+  /**
+   * @brief invalidate_geometry drops the geometry of @code object in all frames.
+   */
+  void invalidate_geometry(const Object& object);
+
+  /**
+   * @brief forget drops everything stored for @code property or @code object.
+   *  It must be called when they are destroyed, since the cache is keyed by address.
+   *  The pointers are not dereferenced.
+   */
+  void forget(const Property* property);
+  void forget(const Object* object);
+
+private:
+  struct Frame
+  {
+    std::optional<Values> values;
+    bool depends_on_tags = false;
+    std::map<const Object*, Geom::PathVector> geometry;
+    std::size_t size = 0;
+    std::list<int>::iterator lru_position;
+  };
+
+  std::map<int, Frame> m_frames;
+
+  // the most recently used frame is at the front.
+  std::list<int> m_lru;
+  std::size_t m_size = 0;
+  std::size_t m_budget = 0;
+  bool m_caches_geometry = true;
+
+  /**
+   * @brief use returns the frame, which is created if it does not exist, and marks it as the
+   *  most recently used one.
+   */
+  Frame& use(int frame);
+  void erase(std::map<int, Frame>::iterator it);
+  void resize(Frame& frame, std::size_t new_size);
+  void evict();
+};
+
+}  // namespace omm
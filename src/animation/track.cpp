@@ -1,4 +1,5 @@
 #include "animation/track.h"
+#include <cmath>
 #include "logging.h"
 #include "common.h"
 #include "properties/property.h"
@@ -11,28 +12,47 @@ using Interpolation = omm::Track::Interpolation;
 
 double interpolate(const std::array<double, 4>& segment, double t, Interpolation interpolation)
 {
-  std::array<double, 4> bernstein4 {
-    1.0 * (1-t) * (1-t) * (1-t),
-    3.0 *   t   * (1-t) * (1-t),
-    3.0 *   t   *   t   * (1-t),
-    1.0 *   t   *   t   *   t
-  };
   switch (interpolation) {
   case Interpolation::Step:
     return segment[0];
   case Interpolation::Linear:
     return (1.0-t) * segment[0] + t * segment[3];
   case Interpolation::Bezier:
+  {
+    const std::array<double, 4> bernstein4 {
+      1.0 * (1-t) * (1-t) * (1-t),
+      3.0 *   t   * (1-t) * (1-t),
+      3.0 *   t   *   t   * (1-t),
+      1.0 *   t   *   t   *   t
+    };
     return bernstein4[0] * segment[0]
          + bernstein4[1] * segment[1]
          + bernstein4[2] * segment[2]
          + bernstein4[3] * segment[3];
+  }
   default:
     Q_UNREACHABLE();
     return 0.0;
   }
 }
 
+using Knot = omm::Track::Knot;
+double interpolate(const std::pair<const int, std::unique_ptr<Knot>>& left,
+                   const std::pair<const int, std::unique_ptr<Knot>>& right,
+                   double frame, std::size_t channel, Interpolation interpolation)
+{
+  const double t = (frame - left.first) / static_cast<double>(right.first - left.first);
+  const double left_value = omm::get_channel_value(left.second->value, channel);
+  const double right_value = omm::get_channel_value(right.second->value, channel);
+  const std::array<double, 4> segment {
+    left_value,
+    left_value + omm::get_channel_value(left.second->right_offset, channel),
+    right_value + omm::get_channel_value(right.second->left_offset, channel),
+    right_value
+  };
+  return interpolate(segment, t, interpolation);
+}
+
 }  // namespace
 
 namespace omm
@@ -108,75 +128,81 @@ void Track::deserialize(AbstractDeserializer& deserializer, const Pointer& point
     }
     const int frame = deserializer.get_int(make_pointer(knot_pointer, FRAME_KEY));
     m_knots.insert(std::pair(frame, std::move(knot)));
+    m_last_upper_bound.reset();
   }
 }
 
 std::unique_ptr<Track::Knot> Track::remove_knot(int frame)
 {
   assert (m_knots.find(frame) != m_knots.end());
+  m_last_upper_bound.reset();
   return std::move(m_knots.extract(frame).mapped());
 }
 
 double Track::interpolate(double frame, std::size_t channel) const
 {
-  // this can be optimized!
-  return get_channel_value(interpolate(frame), channel);
+  assert(!m_knots.empty());
+  const auto right = upper_bound(frame);
+  if (right == m_knots.begin()) {
+    return get_channel_value(right->second->value, channel);
+  }
+
+  const auto left = std::prev(right);
+  if (right == m_knots.end() || left->first == frame) {
+    return get_channel_value(left->second->value, channel);
+  } else {
+    return ::interpolate(*left, *right, frame, channel, m_interpolation);
+  }
 }
 
 variant_type Track::interpolate(double frame) const
 {
   assert(!m_knots.empty());
+  const auto right = upper_bound(frame);
+  if (right == m_knots.begin()) {
+    return right->second->value;
+  }
 
-  if (const auto it = m_knots.find(frame); it != m_knots.end()) {
-    return it->second->value;
+  const auto left = std::prev(right);
+  if (right == m_knots.end() || left->first == frame) {
+    return left->second->value;
   }
 
-  const Knot* left = nullptr;
-  int left_frame = 0;
-  const Knot* right = nullptr;
-  int right_frame = 0;
-  for (auto it = m_knots.cbegin(); it != m_knots.cend(); ++it) {
-    if (it->first <= frame) {
-      left_frame = it->first;
-      left = it->second.get();
-    } else {
-      assert(it->first > frame);
-      right_frame = it->first;
-      right = it->second.get();
-      break;
+  const std::size_t n = n_channels(left->second->value);
+  assert(n == n_channels(right->second->value));
+  if (n == 0) {
+    return left->second->value;  // non-numerical types cannot be interpolated.
+  } else {
+    variant_type interpolated = left->second->value;
+    assert(interpolated.index() == property().variant_value().index());
+    for (std::size_t channel = 0; channel < n; ++channel) {
+      const double v = ::interpolate(*left, *right, frame, channel, m_interpolation);
+      set_channel_value(interpolated, channel, v);
     }
+    assert(interpolated.index() == property().variant_value().index());
+    return interpolated;
   }
+}
 
-  if (left == nullptr && right != nullptr) {
-    return right->value;
-  } else if (left != nullptr && right == nullptr) {
-    return left->value;
-  } else {
-    assert(left != nullptr && right != nullptr);
-    const std::size_t n = n_channels(left->value);
-    assert(n == n_channels(right->value));
-    if (n == 0) {
-      return left->value;  // non-numerical types cannot be interpolated.
-    } else {
-      const double t = (frame - left_frame) / static_cast<double>(right_frame - left_frame);
-      variant_type interpolated = left->value;
-      assert(interpolated.index() == property().variant_value().index());
-      for (std::size_t channel = 0; channel < n; ++channel) {
-        const double left_value = get_channel_value(left->value, channel);
-        const double right_value = get_channel_value(right->value, channel);
-        const std::array<double, 4> segment {
-          left_value,
-          left_value + get_channel_value(left->right_offset, channel),
-          right_value + get_channel_value(right->left_offset, channel),
-          right_value
-        };
-        const double v = ::interpolate(segment, t, m_interpolation);
-        set_channel_value(interpolated, channel, v);
-      }
-      assert(interpolated.index() == property().variant_value().index());
-      return interpolated;
+Track::Knots::const_iterator Track::upper_bound(double frame) const
+{
+  const auto is_upper_bound = [this, frame](const Knots::const_iterator& it) {
+    return (it == m_knots.end() || it->first > frame)
+        && (it == m_knots.begin() || std::prev(it)->first <= frame);
+  };
+
+  if (m_last_upper_bound) {
+    // subsequent queries usually hit the same or the next bracket.
+    if (const auto it = *m_last_upper_bound; is_upper_bound(it)) {
+      return it;
+    } else if (it != m_knots.end() && is_upper_bound(std::next(it))) {
+      m_last_upper_bound = std::next(it);
+      return *m_last_upper_bound;
     }
   }
+
+  m_last_upper_bound = m_knots.upper_bound(static_cast<int>(std::floor(frame)));
+  return *m_last_upper_bound;
 }
 
 Track::Knot& Track::knot(int frame) const
@@ -200,6 +226,7 @@ void Track::apply(int frame) const
 
 void Track::move_knot(int old_frame, int new_frame)
 {
+  m_last_upper_bound.reset();
   auto knot = std::move(m_knots.extract(old_frame).mapped());
   m_knots.insert({ new_frame, std::move(knot) });
 }
@@ -208,6 +235,7 @@ void Track::insert_knot(int frame, std::unique_ptr<Knot> knot)
 {
   assert(knot->value.index() == property().variant_value().index());
   assert(m_knots.find(frame) == m_knots.end());
+  m_last_upper_bound.reset();
   m_knots.insert({ frame, std::move(knot) });
 }
 
@@ -2,6 +2,7 @@
 
 #include "aspects/serializable.h"
 #include <map>
+#include <optional>
 #include "abstractfactory.h"
 #include <QObject>
 #include "serializers/abstractserializer.h"
@@ -77,6 +78,11 @@ public:
 
   bool has_keyframe(int frame) const { return m_knots.find(frame) != m_knots.end(); }
 
+  /**
+   * @brief interpolate returns the value of the track at @code frame.
+   *  The knots around @code frame are found in O(log n). Evaluating subsequent frames in order
+   *  (playback, drawing curves) takes constant amortized time.
+   */
   double interpolate(double frame, std::size_t channel) const;
   variant_type interpolate(double frame) const;
   Knot& knot(int frame) const;
@@ -120,8 +126,16 @@ public:
 
 private:
   Property& m_property;
-  std::map<int, std::unique_ptr<Knot>> m_knots;
+  using Knots = std::map<int, std::unique_ptr<Knot>>;
+  Knots m_knots;
   Interpolation m_interpolation = Interpolation::Linear;
+
+  /**
+   * @brief upper_bound returns the first knot whose frame is greater than @code frame.
+   *  The result is cached and the next query starts at the cached knot.
+   */
+  Knots::const_iterator upper_bound(double frame) const;
+  mutable std::optional<Knots::const_iterator> m_last_upper_bound;
 };
 
 }  // namespace omm
@@ -9,16 +9,7 @@
 #include "scene/messagebox.h"
 #include "animation/track.h"
 #include <random>
-
-namespace
-{
-
-constexpr auto PROPERTIES_POINTER = "properties";
-constexpr auto PROPERTY_TYPE_POINTER = "type";
-constexpr auto PROPERTY_KEY_POINTER = "key";
-constexpr auto ID_POINTER = "id";
-
-}  // namespace
+#include <algorithm>
 
 namespace omm
 {
@@ -62,6 +53,21 @@ Property *AbstractPropertyOwner::property(const QString& key) const
   }
 }
 
+Property* AbstractPropertyOwner::property(const PropertyKey& key) const
+{
+  const std::size_t slot = key.m_slot.load(std::memory_order_relaxed);
+  if (slot < m_slots.size() && m_slots[slot].key_id == key.id()) {
+    return m_slots[slot].property;
+  }
+  for (std::size_t i = 0; i < m_slots.size(); ++i) {
+    if (m_slots[i].key_id == key.id()) {
+      key.m_slot.store(i, std::memory_order_relaxed);
+      return m_slots[i].property;
+    }
+  }
+  return nullptr;
+}
+
 bool AbstractPropertyOwner::has_property(const QString& key) const
 {
   return m_properties.contains(key);
@@ -129,6 +135,7 @@ Property
   assert(!m_properties.contains(key));
   assert(property.get() != nullptr);
   m_properties.insert(key, std::move(property));
+  m_slots.push_back({ PropertyKey::intern(key), &ref });
   connect(&ref, SIGNAL(value_changed(Property*)),
           this, SLOT(on_property_value_changed(Property*)));
   connect(&ref, &Property::value_changed, [this, key](Property* property) {
@@ -148,6 +155,10 @@ QString AbstractPropertyOwner::name() const
 std::unique_ptr<Property> AbstractPropertyOwner::extract_property(const QString& key)
 {
   auto property = m_properties.extract(key);
+  const auto is_extracted = [&property](const Slot& slot) {
+    return slot.property == property.get();
+  };
+  m_slots.erase(std::remove_if(m_slots.begin(), m_slots.end(), is_extracted), m_slots.end());
   disconnect(property.get(), &Property::value_changed, this, nullptr);
   return property;
 }
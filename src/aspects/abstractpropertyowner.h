@@ -4,6 +4,7 @@
 #include <map>
 #include <memory>
 #include <typeinfo>
+#include <vector>
 #include <variant>
 #include <QObject>
 
@@ -14,6 +15,8 @@
 #include <Qt>
 #include "aspects/typed.h"
 #include "properties/property.h"
+#include "properties/propertykey.h"
+#include "properties/typedproperty.h"
 
 namespace omm
 {
@@ -37,6 +40,30 @@ protected:
 public:
   ~AbstractPropertyOwner() override;
   Property* property(const QString& key) const;
+
+  /**
+   * @brief property returns the property @code key or nullptr if there is no such property.
+   *  It compares interned ids and starts at the slot @code key was found last.
+   */
+  Property* property(const PropertyKey& key) const;
+
+  /**
+   * @brief property_value returns the value of the property @code key without copying it.
+   *  The property must exist and must be a `TypedProperty<ValueT>`.
+   */
+  template<typename ValueT> std::enable_if_t<!std::is_enum_v<ValueT>, const ValueT&>
+  property_value(const PropertyKey& key) const
+  {
+    const Property* property = this->property(key);
+    assert(dynamic_cast<const TypedProperty<ValueT>*>(property) != nullptr);
+    return static_cast<const TypedProperty<ValueT>*>(property)->value();
+  }
+
+  template<typename EnumT> std::enable_if_t<std::is_enum_v<EnumT>, EnumT>
+  property_value(const PropertyKey& key) const
+  {
+    return static_cast<EnumT>(property_value<std::size_t>(key));
+  }
   bool has_property(const QString& key) const;
   template<typename ValueT> bool has_property(const QString& key) const
   {
@@ -57,6 +84,10 @@ public:
   virtual QString name() const;
 
   static const QString NAME_PROPERTY_KEY;
+  static constexpr auto PROPERTIES_POINTER = "properties";
+  static constexpr auto PROPERTY_TYPE_POINTER = "type";
+  static constexpr auto PROPERTY_KEY_POINTER = "key";
+  static constexpr auto ID_POINTER = "id";
 
   /**
    * @brief add_property adds a property to this abstract PropertyOwner.
@@ -99,6 +130,14 @@ Q_SIGNALS:
 
 private:
   OrderedMap<QString, Property> m_properties;
+
+  // the properties in the order of `m_properties.keys()` with the interned ids of their keys.
+  struct Slot
+  {
+    std::size_t key_id;
+    Property* property;
+  };
+  std::vector<Slot> m_slots;
   Scene* m_scene = nullptr;
 
   /**
@@ -2,6 +2,7 @@
 
 #include <map>
 #include <tuple>
+#include <cstddef>
 
 template<typename T, typename Self, typename... Args>
 class ArgsCachedGetter
@@ -42,7 +43,17 @@ public:
     return m_cache;
   }
 
-  void invalidate() { m_is_dirty = true; }
+  void invalidate()
+  {
+    m_is_dirty = true;
+    m_version += 1;
+  }
+
+  /**
+   * @brief version is incremented each time the cache is invalidated.
+   *  Dependent caches can store the version they were computed with to detect staleness.
+   */
+  std::size_t version() const { return m_version; }
 
 protected:
   virtual T compute() const = 0;
@@ -51,4 +62,5 @@ protected:
 private:
   mutable T m_cache;
   mutable bool m_is_dirty = true;
+  std::size_t m_version = 0;
 };
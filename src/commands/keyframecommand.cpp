@@ -193,9 +193,11 @@ void MoveKeyFrameCommand::shift_keyframes(bool invert)
 }
 
 ChangeKeyFrameCommand
-::ChangeKeyFrameCommand(int frame, Property& property, std::unique_ptr<Track::Knot> new_value)
+::ChangeKeyFrameCommand(Animator& animator, int frame, Property& property,
+                        std::unique_ptr<Track::Knot> new_value)
   : Command(QObject::tr("Change Keyframes"))
-  , m_frame(frame), m_property(property), m_other_value(std::move(new_value))
+  , m_animator(animator), m_frame(frame), m_property(property)
+  , m_other_value(std::move(new_value))
 {
 }
 
@@ -207,7 +209,9 @@ bool ChangeKeyFrameCommand::mergeWith(const QUndoCommand* other)
 
 void ChangeKeyFrameCommand::swap()
 {
-  m_property.track()->knot(m_frame).swap(*m_other_value);
+  Track& track = *m_property.track();
+  track.knot(m_frame).swap(*m_other_value);
+  Q_EMIT m_animator.knot_changed(track, m_frame);
 }
 
 }  // namespace omm
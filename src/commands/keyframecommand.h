@@ -71,13 +71,15 @@ private:
 class ChangeKeyFrameCommand : public Command
 {
 public:
-  ChangeKeyFrameCommand(int frame, Property& property, std::unique_ptr<Track::Knot> new_value);
+  ChangeKeyFrameCommand(Animator& animator, int frame, Property& property,
+                        std::unique_ptr<Track::Knot> new_value);
   void undo() override { swap(); }
   void redo() override { swap(); }
   bool mergeWith(const QUndoCommand* other) override;
   int id() const override { return CHANGE_KEYFRAMES_COMMAND_ID; }
 
 private:
+  Animator& m_animator;
   const int m_frame;
   Property& m_property;
   std::unique_ptr<Track::Knot> m_other_value;
@@ -1,6 +1,7 @@
 #include "commands/setinterpolationcommand.h"
 #include "properties/property.h"
 #include "animation/track.h"
+#include "animation/animator.h"
 #include <QObject>
 
 namespace
@@ -23,18 +24,21 @@ namespace omm
 {
 
 SetInterpolationCommand::
-SetInterpolationCommand(const std::set<Property*>& properties, Track::Interpolation interpolation)
+SetInterpolationCommand(Animator& animator, const std::set<Property*>& properties,
+                        Track::Interpolation interpolation)
   : Command(QObject::tr("Set Interpolation"))
+  , m_animator(animator)
   , m_others(collect(properties, interpolation))
 {
 }
 
 void SetInterpolationCommand::swap()
 {
-  for (auto& [property, interpolation] : m_others) {
-    const Track::Interpolation i = property->interpolation();
-    property->set_interpolation(interpolation);
+  for (auto& [track, interpolation] : m_others) {
+    const Track::Interpolation i = track->interpolation();
+    track->set_interpolation(interpolation);
     interpolation = i;
+    Q_EMIT m_animator.interpolation_changed(*track);
   }
 }
 
@@ -8,16 +8,19 @@ namespace omm
 {
 
 class Property;
+class Animator;
 
 class SetInterpolationCommand : public Command
 {
 public:
-  SetInterpolationCommand(const std::set<Property*>& properties, Track::Interpolation interpolation);
+  SetInterpolationCommand(Animator& animator, const std::set<Property*>& properties,
+                          Track::Interpolation interpolation);
   void undo() { swap(); }
   void redo() { swap(); }
 
 private:
   void swap();
+  Animator& m_animator;
   std::map<Track*, Track::Interpolation> m_others;
 };
 
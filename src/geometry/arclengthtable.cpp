@@ -0,0 +1,112 @@
+#include "geometry/arclengthtable.h"
+#include <algorithm>
+#include <iterator>
+#include <cstddef>
+
+namespace
+{
+
+/**
+ * @brief find_segment returns the index `i` such that `offsets[i] <= d < offsets[i+1]`.
+ *  `offsets` must be sorted and contain at least two items.
+ *  The result is clamped to the valid range [0, offsets.size() - 2].
+ */
+template<typename Iterator> std::size_t find_segment(Iterator begin, Iterator end, double d)
+{
+  const std::ptrdiff_t i = std::distance(begin, std::upper_bound(begin, end, d)) - 1;
+  const std::ptrdiff_t n = std::distance(begin, end);
+  return static_cast<std::size_t>(std::clamp<std::ptrdiff_t>(i, 0, n - 2));
+}
+
+double fraction(double d, double begin, double end)
+{
+  return end > begin ? std::clamp((d - begin) / (end - begin), 0.0, 1.0) : 0.0;
+}
+
+}  // namespace
+
+namespace omm
+{
+
+ArcLengthTable::ArcLengthTable(const Geom::PathVector& paths)
+{
+  static constexpr auto n = SAMPLES_PER_CURVE;
+  m_paths.reserve(paths.size());
+  m_path_offsets.reserve(paths.size() + 1);
+  for (const Geom::Path& path : paths) {
+    PathTable table;
+    table.curve_offsets.reserve(path.size() + 1);
+    table.curve_offsets.push_back(0.0);
+    table.samples.reserve(path.size() * (n + 1));
+    for (const Geom::Curve& curve : path) {
+      // a polyline with SAMPLES_PER_CURVE segments approximates the arc length sufficiently well
+      // and yields a monotonic table that can be inverted by interpolation.
+      double accu = 0.0;
+      Geom::Point last = curve.pointAt(0.0);
+      table.samples.push_back(accu);
+      for (std::size_t i = 1; i <= n; ++i) {
+        const Geom::Point current = curve.pointAt(static_cast<double>(i) / n);
+        accu += Geom::distance(last, current);
+        table.samples.push_back(accu);
+        last = current;
+      }
+      table.curve_offsets.push_back(table.curve_offsets.back() + accu);
+    }
+    m_path_offsets.push_back(m_path_offsets.back() + table.curve_offsets.back());
+    m_paths.push_back(std::move(table));
+  }
+}
+
+Geom::PathVectorTime ArcLengthTable::time(double t) const
+{
+  if (m_paths.empty()) {
+    return Geom::PathVectorTime(0, 0, 0.0);
+  }
+  const double d = std::clamp(t, 0.0, 1.0) * length();
+  const auto path_index = find_segment(m_path_offsets.begin(), m_path_offsets.end(), d);
+  return time(path_index, m_paths[path_index], d - m_path_offsets[path_index]);
+}
+
+Geom::PathVectorTime ArcLengthTable::time(std::size_t path_index, double t) const
+{
+  if (path_index >= m_paths.size()) {
+    return Geom::PathVectorTime(path_index, 0, 0.0);
+  }
+  const double d = std::clamp(t, 0.0, 1.0) * length(path_index);
+  return time(path_index, m_paths[path_index], d);
+}
+
+Geom::PathVectorTime
+ArcLengthTable::time(std::size_t path_index, const PathTable& table, double d) const
+{
+  static constexpr auto n = SAMPLES_PER_CURVE;
+  const auto& offsets = table.curve_offsets;
+  if (offsets.size() < 2) {
+    return Geom::PathVectorTime(path_index, 0, 0.0);
+  }
+
+  const auto curve_index = find_segment(offsets.begin(), offsets.end(), d);
+  d -= offsets[curve_index];
+
+  const double* samples = table.samples.data() + curve_index * (n + 1);
+  const auto sample_index = find_segment(samples, samples + n + 1, d);
+  const double s = fraction(d, samples[sample_index], samples[sample_index + 1]);
+  const double curve_time = (static_cast<double>(sample_index) + s) / n;
+  return Geom::PathVectorTime(path_index, curve_index, curve_time);
+}
+
+double ArcLengthTable::length() const
+{
+  return m_path_offsets.back();
+}
+
+double ArcLengthTable::length(std::size_t path_index) const
+{
+  if (path_index >= m_paths.size()) {
+    return 0.0;
+  } else {
+    return m_paths[path_index].curve_offsets.back();
+  }
+}
+
+}  // namespace omm
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <vector>
+#include "2geom/pathvector.h"
+
+namespace omm
+{
+
+/**
+ * @brief The ArcLengthTable class maps normalized distances to curve times.
+ *  It stores the cumulative arc length of each path, each curve and of a fixed number of samples
+ *  per curve. Lookups are hence a binary search followed by a linear interpolation between two
+ *  samples, which approximates the inverse arc-length function of the curve.
+ */
+class ArcLengthTable
+{
+public:
+  explicit ArcLengthTable() = default;
+  explicit ArcLengthTable(const Geom::PathVector& paths);
+
+  static constexpr std::size_t SAMPLES_PER_CURVE = 32;
+
+  /**
+   * @brief time returns the curve time at distance `t * length()` from the beginning of the
+   *  path vector.
+   * @param t normalized distance, it is clamped to [0, 1].
+   */
+  Geom::PathVectorTime time(double t) const;
+
+  /**
+   * @brief time returns the curve time at distance `t * length(path_index)` from the beginning
+   *  of the path with index `path_index`.
+   * @param t normalized distance, it is clamped to [0, 1].
+   */
+  Geom::PathVectorTime time(std::size_t path_index, double t) const;
+
+  double length() const;
+  double length(std::size_t path_index) const;
+
+private:
+  struct PathTable
+  {
+    // cumulative length of the curves, begins with 0.0. Has one more item than curves.
+    std::vector<double> curve_offsets;
+
+    // for each curve, the cumulative length at SAMPLES_PER_CURVE + 1 uniform curve times.
+    std::vector<double> samples;
+  };
+
+  // cumulative length of the paths, begins with 0.0. Has one more item than paths.
+  std::vector<double> m_path_offsets = { 0.0 };
+  std::vector<PathTable> m_paths;
+
+  Geom::PathVectorTime time(std::size_t path_index, const PathTable& table, double d) const;
+};
+
+}  // namespace omm
@@ -83,6 +83,16 @@ bool BoundingBox::contains(const BoundingBox& other) const
   }
 }
 
+bool BoundingBox::intersects(const BoundingBox& other) const
+{
+  if (is_empty() || other.is_empty()) {
+    return false;
+  } else {
+    return left() <= other.right() && other.left() <= right()
+        && top() <= other.bottom() && other.top() <= bottom();
+  }
+}
+
 std::ostream& operator<<(std::ostream &ostream, const BoundingBox &bb)
 {
   ostream << "BoundingBox[" << bb.top_left() << ", " << bb.width() << "x" << bb.height() << "]";
@@ -117,7 +127,8 @@ BoundingBox operator|(const BoundingBox& a, const BoundingBox& b)
   } else if (b.is_empty()) {
     return a;
   } else {
-    return BoundingBox({ b.top_left(), b.bottom_right(), a.top_left(), a.bottom_right() });
+    return BoundingBox(Vec2f::min(a.top_left(), b.top_left()),
+                       Vec2f::max(a.bottom_right(), b.bottom_right()));
   }
 }
 
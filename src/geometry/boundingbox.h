@@ -23,6 +23,12 @@ public:
   bool contains(const BoundingBox& other) const;
   using Rectangle::contains;
 
+  /**
+   * @brief intersects returns whether this and @code other overlap.
+   *  Empty bounding boxes do not intersect anything.
+   */
+  bool intersects(const BoundingBox& other) const;
+
   BoundingBox& operator |=(const BoundingBox& other);
   BoundingBox& operator |=(const Vec2f& point);
 
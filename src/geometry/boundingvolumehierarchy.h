@@ -0,0 +1,179 @@
+#pragma once
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+#include "geometry/boundingbox.h"
+
+namespace omm
+{
+
+/**
+ * @brief The BoundingVolumeHierarchy class is a binary tree of bounding boxes.
+ *  It finds the items whose bounding box intersects a region in O(log n + k).
+ *  The bounding box of an item can be updated, which refits the boxes of the tree but keeps its
+ *  structure. Build a new hierarchy if items are added or removed.
+ *  Items with an empty bounding box are never found.
+ */
+template<typename T> class BoundingVolumeHierarchy
+{
+public:
+  struct Item
+  {
+    BoundingBox bounding_box;
+    T value;
+  };
+
+  explicit BoundingVolumeHierarchy(std::vector<Item> items = {})
+    : m_positions(items.size(), NONE)
+  {
+    m_entries.reserve(items.size());
+    for (std::size_t i = 0; i < items.size(); ++i) {
+      if (!items[i].bounding_box.is_empty()) {
+        m_entries.push_back(Entry{ std::move(items[i]), i });
+      }
+    }
+    if (!m_entries.empty()) {
+      m_nodes.reserve(2 * m_entries.size() / LEAF_SIZE + 1);
+      build(0, m_entries.size(), NONE);
+      m_leaves.resize(m_entries.size());
+      for (std::size_t n = 0; n < m_nodes.size(); ++n) {
+        if (m_nodes[n].is_leaf()) {
+          for (std::size_t i = m_nodes[n].begin; i < m_nodes[n].end; ++i) {
+            m_leaves[i] = n;
+            m_positions[m_entries[i].index] = i;
+          }
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief query returns the values of all items whose bounding box intersects @code region.
+   *  The order of the values is unspecified.
+   */
+  std::vector<T> query(const BoundingBox& region) const
+  {
+    std::vector<T> values;
+    if (!m_nodes.empty()) {
+      query(0, region, values);
+    }
+    return values;
+  }
+
+  /**
+   * @brief update sets the bounding box of the item at @code index of the vector which was passed
+   *  to the constructor and refits the boxes of its ancestors in O(log n).
+   *  The tree is not restructured, hence queries become slower if many items move far.
+   * @return false if the item is not part of the hierarchy because its box was empty or if
+   *  @code bounding_box is empty. The hierarchy is not changed then, build a new one.
+   */
+  bool update(std::size_t index, const BoundingBox& bounding_box)
+  {
+    if (bounding_box.is_empty() || index >= m_positions.size() || m_positions[index] == NONE) {
+      return false;
+    }
+
+    const std::size_t position = m_positions[index];
+    m_entries[position].item.bounding_box = bounding_box;
+    for (std::size_t n = m_leaves[position]; n != NONE; n = m_nodes[n].parent) {
+      Node& node = m_nodes[n];
+      const BoundingBox refit = node.is_leaf()
+          ? this->bounding_box(node.begin, node.end)
+          : m_nodes[n + 1].bounding_box | m_nodes[node.right_child].bounding_box;
+      if (refit == node.bounding_box) {
+        break;  // the ancestors are not affected.
+      }
+      node.bounding_box = refit;
+    }
+    return true;
+  }
+
+  std::size_t size() const { return m_entries.size(); }
+
+private:
+  static constexpr std::size_t LEAF_SIZE = 8;
+  static constexpr std::size_t NONE = std::numeric_limits<std::size_t>::max();
+
+  struct Entry
+  {
+    Item item;
+
+    // the index of the item in the vector passed to the constructor.
+    std::size_t index;
+  };
+
+  struct Node
+  {
+    BoundingBox bounding_box;
+    std::size_t begin;
+    std::size_t end;
+    std::size_t parent;
+
+    // the left child immediately follows its parent. Leafs have no children.
+    std::size_t right_child;
+    bool is_leaf() const { return right_child == 0; }
+  };
+
+  std::vector<Entry> m_entries;
+  std::vector<Node> m_nodes;
+
+  // the position in `m_entries` of each item passed to the constructor or NONE.
+  std::vector<std::size_t> m_positions;
+
+  // the leaf node of each entry.
+  std::vector<std::size_t> m_leaves;
+
+  BoundingBox bounding_box(const std::size_t begin, const std::size_t end) const
+  {
+    Vec2f min = m_entries[begin].item.bounding_box.top_left();
+    Vec2f max = m_entries[begin].item.bounding_box.bottom_right();
+    for (std::size_t i = begin + 1; i < end; ++i) {
+      min = Vec2f::min(min, m_entries[i].item.bounding_box.top_left());
+      max = Vec2f::max(max, m_entries[i].item.bounding_box.bottom_right());
+    }
+    return BoundingBox(min, max);
+  }
+
+  std::size_t build(const std::size_t begin, const std::size_t end, const std::size_t parent)
+  {
+    const BoundingBox bounding_box = this->bounding_box(begin, end);
+    const std::size_t index = m_nodes.size();
+    m_nodes.push_back(Node{ bounding_box, begin, end, parent, 0 });
+    if (end - begin > LEAF_SIZE) {
+      // split at the median of the box centers along the larger extent.
+      const std::size_t axis = bounding_box.width() >= bounding_box.height() ? 0 : 1;
+      const auto center = [axis](const Entry& entry) {
+        const BoundingBox& box = entry.item.bounding_box;
+        return box.top_left()[axis] + box.bottom_right()[axis];
+      };
+      const std::size_t mid = begin + (end - begin) / 2;
+      std::nth_element(m_entries.begin() + begin, m_entries.begin() + mid,
+                       m_entries.begin() + end,
+                       [center](const Entry& a, const Entry& b) { return center(a) < center(b); });
+      build(begin, mid, index);
+      const std::size_t right_child = build(mid, end, index);
+      m_nodes[index].right_child = right_child;
+    }
+    return index;
+  }
+
+  void query(const std::size_t index, const BoundingBox& region, std::vector<T>& values) const
+  {
+    const Node& node = m_nodes[index];
+    if (!node.bounding_box.intersects(region)) {
+      return;
+    } else if (node.is_leaf()) {
+      for (std::size_t i = node.begin; i < node.end; ++i) {
+        if (m_entries[i].item.bounding_box.intersects(region)) {
+          values.push_back(m_entries[i].item.value);
+        }
+      }
+    } else {
+      query(index + 1, region, values);
+      query(node.right_child, region, values);
+    }
+  }
+};
+
+}  // namespace omm
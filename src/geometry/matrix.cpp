@@ -77,17 +77,17 @@ Matrix Matrix::operator*(const Matrix& other) const
 
 Vec2f Matrix::apply_to_position(const Vec2f& p) const
 {
-  return apply(std::vector{ p.x, p.y, 1.0 });
+  return apply({ p.x, p.y, 1.0 });
 }
 
 Vec2f Matrix::apply_to_direction(const Vec2f& d) const
 {
-  return apply(std::vector{ d.x, d.y, 0.0 });
+  return apply({ d.x, d.y, 0.0 });
 }
 
-Vec2f Matrix::apply(const std::vector<double>& vec) const
+Vec2f Matrix::apply(const std::array<double, 3>& vec) const
 {
-  std::vector<double> result { 0.0, 0.0, 0.0 };
+  std::array<double, 3> result { 0.0, 0.0, 0.0 };
   for (std::size_t i = 0; i < 3; ++i) {
     for (std::size_t j = 0; j < 3; ++j) {
       result[i] += vec[j] * m[i][j];
@@ -2,6 +2,7 @@
 
 #include "geometry/vec2.h"
 
+#include <array>
 #include <QMatrix>
 #include <QGenericMatrix>
 
@@ -29,7 +30,7 @@ public:
   QMatrix3x3 to_qmatrix3x3() const;
 
 private:
-  Vec2f apply(const std::vector<double>& vec) const;
+  Vec2f apply(const std::array<double, 3>& vec) const;
 };
 
 }  // namespace omm
@@ -20,31 +20,49 @@ ObjectTransformation::ObjectTransformation(const Matrix& mat) { set_mat(mat); }
 
 void ObjectTransformation::set_translation(const Vec2f& translation_vector)
 {
+  prepare_component_modification();
   m_translation = translation_vector;
 }
 
 void ObjectTransformation::set_rotation(const double& angle)
 {
+  prepare_component_modification();
   m_rotation = angle;
 }
 
-void ObjectTransformation::set_shearing(const double& shear) { m_shearing = shear; }
+void ObjectTransformation::set_shearing(const double& shear)
+{
+  prepare_component_modification();
+  m_shearing = shear;
+}
 
 void ObjectTransformation::set_scaling(const Vec2f& scale_vector)
 {
+  prepare_component_modification();
   m_scaling = scale_vector;
 }
 
 void ObjectTransformation::translate(const Vec2f& translation_vector)
 {
+  prepare_component_modification();
   m_translation += translation_vector;
 }
 
-void ObjectTransformation::rotate(const double& angle) { m_rotation += angle; }
-void ObjectTransformation::shear(const double& shear) { m_shearing += shear; }
+void ObjectTransformation::rotate(const double& angle)
+{
+  prepare_component_modification();
+  m_rotation += angle;
+}
+
+void ObjectTransformation::shear(const double& shear)
+{
+  prepare_component_modification();
+  m_shearing += shear;
+}
 
 void ObjectTransformation::scale(const Vec2f& scale_vector)
 {
+  prepare_component_modification();
   m_scaling.x *= scale_vector.x;
   m_scaling.y *= scale_vector.y;
 }
@@ -77,8 +95,12 @@ ObjectTransformation ObjectTransformation::scaled(const Vec2f& scale_vector) con
   return scaled;
 }
 
-Matrix ObjectTransformation::to_mat() const
+const Matrix& ObjectTransformation::to_mat() const
 {
+  if (m_mat) {
+    return *m_mat;
+  }
+
   const Matrix translation({ { 1, 0, m_translation.x },
                              { 0, 1, m_translation.y },
                              { 0, 0, 1                } });
@@ -92,11 +114,45 @@ Matrix ObjectTransformation::to_mat() const
                           { m_shearing, 1, 0 },
                           { 0,          0, 1 } });
 
-  return translation * rotation * scaling * shearing;
+  m_mat = translation * rotation * scaling * shearing;
+  return *m_mat;
+}
+
+const Matrix& ObjectTransformation::inverse_mat() const
+{
+  if (!m_inverse_mat) {
+    m_inverse_mat = to_mat().inverted();
+  }
+  return *m_inverse_mat;
 }
 
 void ObjectTransformation::set_mat(const Matrix& mat)
 {
+  // TODO NaN can occur if scaling is 0.
+  assert(std::abs(mat.m[2][0] - 0) < 0.0001 || std::isnan(mat.m[2][0]));
+  assert(std::abs(mat.m[2][1] - 0) < 0.0001 || std::isnan(mat.m[2][1]));
+  assert(std::abs(mat.m[2][2] - 1) < 0.0001 || std::isnan(mat.m[2][2]));
+
+  m_mat = mat;
+  m_inverse_mat.reset();
+  m_is_decomposed = false;
+}
+
+void ObjectTransformation::prepare_component_modification()
+{
+  decompose();
+  m_mat.reset();
+  m_inverse_mat.reset();
+}
+
+void ObjectTransformation::decompose() const
+{
+  if (m_is_decomposed) {
+    return;
+  }
+
+  assert(m_mat);
+  const Matrix& mat = *m_mat;
   const double a = mat.m[0][0];
   const double b = mat.m[0][1];
   const double c = mat.m[1][0];
@@ -104,11 +160,6 @@ void ObjectTransformation::set_mat(const Matrix& mat)
 
   m_translation = { mat.m[0][2], mat.m[1][2] };
 
-  // TODO NaN can occur if scaling is 0.
-  assert(std::abs(mat.m[2][0] - 0) < 0.0001 || std::isnan(mat.m[2][0]));
-  assert(std::abs(mat.m[2][1] - 0) < 0.0001 || std::isnan(mat.m[2][1]));
-  assert(std::abs(mat.m[2][2] - 1) < 0.0001 || std::isnan(mat.m[2][2]));
-
   // https://math.stackexchange.com/a/78165/355947
   // translation * scaling * shearing * rotation
   // const double det = a*e - b*d;
@@ -135,12 +186,33 @@ void ObjectTransformation::set_mat(const Matrix& mat)
     m_rotation = std::atan2(c, a);
     m_scaling = Vec2f(std::sqrt(std::pow(c, 2.0) + std::pow(a, 2.0)), sy);
   }
+  m_is_decomposed = true;
+}
+
+Vec2f ObjectTransformation::translation() const
+{
+  decompose();
+  return m_translation;
+}
+
+double ObjectTransformation::rotation() const
+{
+  decompose();
+  return m_rotation;
+}
+
+Vec2f ObjectTransformation::scaling() const
+{
+  decompose();
+  return m_scaling;
+}
+
+double ObjectTransformation::shearing() const
+{
+  decompose();
+  return m_shearing;
 }
 
-Vec2f ObjectTransformation::translation() const { return m_translation; }
-double ObjectTransformation::rotation() const { return m_rotation; }
-Vec2f ObjectTransformation::scaling() const { return m_scaling; }
-double ObjectTransformation::shearing() const { return m_shearing; }
 Vec2f ObjectTransformation::null() const { return apply_to_position(Vec2f::o()); }
 
 std::ostream& operator<<(std::ostream& ostream, const ObjectTransformation& t)
@@ -234,8 +306,9 @@ PolarCoordinates ObjectTransformation::apply_to_direction(const PolarCoordinates
 
 ObjectTransformation ObjectTransformation::inverted() const
 {
-  // TODO caching the inverse might gain some speed
-  return ObjectTransformation(to_mat().inverted());
+  ObjectTransformation inverse(inverse_mat());
+  inverse.m_inverse_mat = to_mat();
+  return inverse;
 }
 
 ObjectTransformation ObjectTransformation::normalized() const
@@ -261,14 +334,14 @@ QTransform ObjectTransformation::to_qtransform() const
 
 bool ObjectTransformation::has_nan() const
 {
+  decompose();
   return   m_translation.has_nan() || m_scaling.has_nan()
          || std::isnan(m_shearing) || std::isnan(m_rotation);
 }
 
 ObjectTransformation ObjectTransformation::transformed(const ObjectTransformation& other) const
 {
-  const auto o = other.to_mat();
-  return ObjectTransformation(o.inverted() * to_mat() * o);
+  return ObjectTransformation(other.inverse_mat() * to_mat() * other.to_mat());
 }
 
 
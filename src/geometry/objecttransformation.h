@@ -7,10 +7,18 @@
 #include "geometry/matrix.h"
 #include <QTransform>
 #include <Qt>
+#include <optional>
 
 namespace omm
 {
 
+/**
+ * @brief The ObjectTransformation class represents an affine transformation.
+ *  It can be set up either by its components (translation, rotation, scaling, shearing) or by a
+ *  matrix. The respective other representation is computed lazily and cached, as is the inverse
+ *  matrix. Hence, composing transformations (`apply`) and mapping points does not involve any
+ *  trigonometric functions once the matrix is known.
+ */
 class ObjectTransformation
 {
 public:
@@ -44,7 +52,7 @@ public:
 
   ObjectTransformation transformed(const ObjectTransformation& other) const;
 
-  Matrix to_mat() const;
+  const Matrix& to_mat() const;
   void set_mat(const Matrix& mat);
 
   Vec2f apply_to_position(const Vec2f& position) const;
@@ -64,10 +72,21 @@ public:
 
   bool has_nan() const;
 private:
-  Vec2f m_translation;
-  Vec2f m_scaling;
-  double m_shearing;
-  double m_rotation;
+  // the components are computed from `m_mat` on demand if `m_is_decomposed` is false.
+  mutable Vec2f m_translation;
+  mutable Vec2f m_scaling;
+  mutable double m_shearing;
+  mutable double m_rotation;
+  mutable bool m_is_decomposed = true;
+  void decompose() const;
+
+  // the matrix is computed from the components on demand, the inverse from the matrix.
+  mutable std::optional<Matrix> m_mat;
+  mutable std::optional<Matrix> m_inverse_mat;
+  const Matrix& inverse_mat() const;
+
+  // must be called before any component is modified.
+  void prepare_component_modification();
 };
 
 std::ostream& operator<<(std::ostream& ostream, const ObjectTransformation& t);
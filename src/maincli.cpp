@@ -5,6 +5,7 @@
 #include "mainwindow/application.h"
 #include "objects/view.h"
 #include "mainwindow/exportdialog.h"
+#include "mainwindow/imagewriter.h"
 #include "animation/animator.h"
 #include <memory>
 #include <QApplication>
@@ -13,6 +14,10 @@
 #include "subcommandlineparser.h"
 #include <QFileInfo>
 #include <QFile>
+#include <QProcess>
+#include <QThread>
+#include <list>
+#include <functional>
 
 
 template<typename T> const T& find(omm::Scene& scene, const QString& name)
@@ -59,16 +64,14 @@ QString interpolate_filename(QString fn_template, int i)
   return fn_template;
 }
 
-void print_tree(const omm::Object& root, const QString& prefix = "")
+void print_tree(const omm::SceneIndex& index, std::size_t i = 0, const QString& prefix = "")
 {
-  const auto tags = ::transform<QString, QList>(root.tags.items(), [](const omm::Tag* tag) {
-    return tag->type();
-  }).join(", ");
-  const auto label = QString("%1[%2] (%3)").arg(root.type()).arg(root.name()).arg(tags);
+  const auto& entry = index.entries().at(i);
+  const auto label = QString("%1[%2] (%3)").arg(entry.type, entry.name, entry.tag_types.join(", "));
   std::cout << prefix.toStdString() << label.toStdString() << "\n";
 
-  for (const omm::Object* c : root.tree_children()) {
-    print_tree(*c, prefix + " ");
+  for (const std::size_t c : entry.children) {
+    print_tree(index, c, prefix + " ");
   }
 }
 
@@ -87,7 +90,13 @@ void prepare_scene(omm::Scene& scene, const std::set<omm::Object*>& visible_obje
   }
 }
 
-void prepare_scene(omm::Scene& scene, const omm::SubcommandLineParser& args)
+using ObjectPredicate = std::function<bool(const QString& name, const QString& tree_path)>;
+
+/**
+ * @brief make_object_predicate returns the predicate matching the objects selected by the
+ *  `object` or `path` options or nullptr if all objects are selected.
+ */
+ObjectPredicate make_object_predicate(const omm::SubcommandLineParser& args)
 {
   const QString& object_name = args.get<QString>("object", "");
   const QString& object_path = args.get<QString>("path", "");
@@ -96,17 +105,43 @@ void prepare_scene(omm::Scene& scene, const omm::SubcommandLineParser& args)
     exit(1);
   }
 
-  const auto predicate = [object_name, object_path](const auto* object) {
-    if (!object_name.isEmpty()) {
-      return QRegularExpression(object_name).match(object->name()).hasMatch();
-    } else if (!object_path.isEmpty()) {
-      return QRegularExpression(object_path).match(object->tree_path()).hasMatch();
-    } else {
-      return true;
-    }
-  };
+  if (!object_name.isEmpty()) {
+    return [regex = QRegularExpression(object_name)](const QString& name, const QString&) {
+      return regex.match(name).hasMatch();
+    };
+  } else if (!object_path.isEmpty()) {
+    return [regex = QRegularExpression(object_path)](const QString&, const QString& tree_path) {
+      return regex.match(tree_path).hasMatch();
+    };
+  } else {
+    return nullptr;
+  }
+}
+
+void prepare_scene(omm::Scene& scene, const ObjectPredicate& predicate)
+{
+  prepare_scene(scene, ::filter_if(scene.object_tree().items(), [&predicate](const auto* object) {
+    return !predicate || predicate(object->name(), object->tree_path());
+  }));
+}
 
-  prepare_scene(scene, ::filter_if(scene.object_tree().items(), predicate));
+void load_scene(omm::Scene& scene, const omm::SubcommandLineParser& args)
+{
+  const QString scene_filename = args.get<QString>("input");
+  const auto predicate = make_object_predicate(args);
+  if (predicate) {
+    // materialize only the selected objects, the objects they depend on and the view.
+    const QString view_name = args.get<QString>("view");
+    const auto filter = [&predicate, view_name](const omm::SceneIndex::Entry& entry,
+                                                const QString& tree_path) {
+      return (entry.type == omm::View::TYPE && entry.name == view_name)
+          || predicate(entry.name, tree_path);
+    };
+    scene.load_from(scene_filename, filter);
+  } else {
+    scene.load_from(scene_filename);
+  }
+  prepare_scene(scene, predicate);
 }
 
 QSize calculate_resolution(int width, const omm::View& view)
@@ -115,29 +150,93 @@ QSize calculate_resolution(int width, const omm::View& view)
   return QSize(width, width / size.x * size.y);
 }
 
+/**
+ * @brief render_in_processes spawns @code n_processes instances of this program, each rendering
+ *  a contiguous part of the sequence [@code start_frame, @code start_frame + @code n_frames].
+ *  Each process loads the scene itself, hence there is no shared state.
+ * @param n_jobs the number of encoder threads of all processes together or 0 for the number of
+ *  cores. They are distributed evenly among the processes.
+ */
+void render_in_processes(int n_processes, int n_jobs, int start_frame, int n_frames)
+{
+  // the sequence contains the start frame and `n_frames` more frames.
+  const int total_frames = n_frames + 1;
+  n_processes = std::min(n_processes, total_frames);
+  if (n_jobs <= 0) {
+    n_jobs = QThread::idealThreadCount();
+  }
+  const int jobs_per_process = std::max(1, n_jobs / n_processes);
+
+  std::list<std::unique_ptr<QProcess>> processes;
+  int first = start_frame;
+  for (int i = 0; i < n_processes; ++i) {
+    const int chunk_size = total_frames / n_processes + (i < total_frames % n_processes ? 1 : 0);
+    auto process = std::make_unique<QProcess>();
+    process->setProcessChannelMode(QProcess::ForwardedChannels);
+
+    // later occurences of an option override the earlier ones.
+    QStringList arguments = QCoreApplication::arguments().mid(1);
+    arguments << "--start-frame" << QString::number(first)
+              << "--sequence-length" << QString::number(chunk_size - 1)
+              << "--processes" << "1"
+              << "--jobs" << QString::number(jobs_per_process);
+    process->start(QCoreApplication::applicationFilePath(), arguments);
+    processes.push_back(std::move(process));
+    first += chunk_size;
+  }
+
+  bool success = true;
+  for (auto&& process : processes) {
+    process->waitForFinished(-1);
+    if (process->error() == QProcess::FailedToStart
+        || process->exitStatus() != QProcess::NormalExit
+        || process->exitCode() != EXIT_SUCCESS)
+    {
+      LERROR << QObject::tr("Worker process failed: %1").arg(process->errorString());
+      success = false;
+    }
+  }
+  if (!success) {
+    exit(EXIT_FAILURE);
+  }
+}
+
 void render(omm::Application& app, const omm::SubcommandLineParser& args)
 {
-  const QString scene_filename = args.get<QString>("input");
-  const QString fn_template = args.get<QString>("output");
-  app.scene.load_from(scene_filename);
-  prepare_scene(app.scene, args);
   const int start_frame = args.get<int>("start-frame", 1);
   const int n_frames = args.get<int>("sequence-length", 1);
+  if (const int n_processes = args.get<int>("processes", 1); n_processes > 1) {
+    render_in_processes(n_processes, args.get<int>("jobs", 0), start_frame, n_frames);
+    return;
+  }
+
+  const QString fn_template = args.get<QString>("output");
+  load_scene(app.scene, args);
   const omm::View& view = find<omm::View>(app.scene, args.get<QString>("view"));
   const bool force = args.isSet("overwrite");
   const auto resolution = calculate_resolution(args.get<int>("width"), view);
+  omm::ImageWriter writer(args.get<int>("jobs", 0));
 
-  const auto render = [&view, resolution, fn_template, force](omm::Animator& animator) {
+  // the scene is evaluated on the main thread, rasterizing and encoding run in parallel.
+  const auto render = [&view, resolution, fn_template, force, &writer](omm::Animator& animator) {
     const QString filename = interpolate_filename(fn_template, animator.current());
     if (QFileInfo::exists(filename) && !force) {
       LERROR << QObject::tr("Refuse to overwrite existing file '%1'.").arg(filename);
       exit(EXIT_FAILURE);
     }
+    if (omm::ExportDialog::requires_streaming(resolution, filename)) {
+      // the image is too large to be kept in memory.
+      if (!omm::ExportDialog::render_png(animator.scene, &view, resolution, filename)) {
+        LERROR << QObject::tr("Failed to write '%1'.").arg(filename);
+        exit(EXIT_FAILURE);
+      }
+      return;
+    }
     QImage image(resolution, QImage::Format_ARGB32_Premultiplied);
     image.fill(Qt::red);
     image.fill(Qt::transparent);
     omm::ExportDialog::render(animator.scene, &view, image);
-    image.save(filename);
+    writer.write(image, filename);
   };
 
   auto& animator = app.scene.animator();
@@ -147,13 +246,33 @@ void render(omm::Application& app, const omm::SubcommandLineParser& args)
     animator.advance();
     render(animator);
   }
+
+  if (!writer.wait()) {
+    exit(EXIT_FAILURE);
+  }
 }
 
 void tree(omm::Application& app, const omm::SubcommandLineParser& args)
 {
-  const QString scene_filename = args.get<QString>("input");
-  app.scene.load_from(scene_filename);
-  print_tree(app.scene.object_tree().root());
+  // the tree is printed from the index, no object needs to be instantiated.
+  const auto index = omm::Scene::index(args.get<QString>("input"));
+  if (!index) {
+    exit(EXIT_FAILURE);
+  }
+  print_tree(*index);
+}
+
+void convert(omm::Application& app, const omm::SubcommandLineParser& args)
+{
+  const QString input_filename = args.get<QString>("input");
+  const QString output_filename = args.get<QString>("output");
+  if (QFileInfo::exists(output_filename) && !args.isSet("overwrite")) {
+    LERROR << QObject::tr("Refuse to overwrite existing file '%1'.").arg(output_filename);
+    exit(EXIT_FAILURE);
+  }
+  if (!app.scene.load_from(input_filename) || !app.scene.save_as(output_filename)) {
+    exit(EXIT_FAILURE);
+  }
 }
 
 std::unique_ptr<omm::Options> make_options(const omm::SubcommandLineParser& args)
@@ -198,6 +317,7 @@ int main(int argc, char* argv[])
   static const std::map<QString, subcommand_t> f_map {
     { "render", &render },
     { "tree", &tree },
+    { "convert", &convert },
   };
 
   if (const auto it = f_map.find(args.command()); it == f_map.end()) {
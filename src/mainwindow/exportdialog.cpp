@@ -6,17 +6,24 @@
 #include <QFrame>
 #include "objects/view.h"
 #include <QPainter>
+#include <QRunnable>
 #include <QSettings>
+#include <QThreadPool>
 #include "renderers/painter.h"
+#include "renderers/pngwriter.h"
 #include "scene/scene.h"
 #include "mainwindow/application.h"
+#include "mainwindow/imagewriter.h"
 #include "mainwindow/mainwindow.h"
 #include "mainwindow/viewport/viewport.h"
 #include <QFileDialog>
 #include <QMessageBox>
+#include <QCoreApplication>
 #include <QLabel>
+#include <QProgressBar>
 #include <QVBoxLayout>
 #include <QtSvg/QSvgGenerator>
+#include "geometry/boundingvolumehierarchy.h"
 #include "geometry/vec2.h"
 #include "ui_exportdialog.h"
 
@@ -52,6 +59,50 @@ double compute_aspect_ratio(const omm::View* view)
 
 const QChar frame_number_placeholder = '%';
 
+/**
+ * @brief The TileRenderer class replays recorded pictures into a rectangle of an image.
+ *  It is run on a worker thread, concurrently with the renderers of the other tiles.
+ */
+class TileRenderer : public QRunnable
+{
+public:
+  TileRenderer(std::vector<QByteArray> pictures, uchar* bits, const QImage& image,
+               const QRect& rect, const QPoint& offset, double scale)
+    : m_pictures(std::move(pictures))
+    , m_bits(bits + rect.y() * image.bytesPerLine() + rect.x() * image.depth() / 8)
+    , m_bytes_per_line(image.bytesPerLine())
+    , m_format(image.format())
+    , m_rect(rect)
+    , m_offset(offset)
+    , m_scale(scale)
+  {
+  }
+
+  void run() override
+  {
+    // the tile shares the memory with the target image. The tiles don't overlap.
+    QImage tile(m_bits, m_rect.width(), m_rect.height(), m_bytes_per_line, m_format);
+    QPainter painter(&tile);
+    painter.translate(-m_rect.topLeft() - m_offset);
+    painter.scale(m_scale, m_scale);
+    for (const QByteArray& data : m_pictures) {
+      // QPicture::play is not reentrant, hence each tile replays its own copy.
+      QPicture picture;
+      picture.setData(data.constData(), static_cast<uint>(data.size()));
+      painter.drawPicture(QPointF(0.0, 0.0), picture);
+    }
+  }
+
+private:
+  const std::vector<QByteArray> m_pictures;
+  uchar* const m_bits;
+  const int m_bytes_per_line;
+  const QImage::Format m_format;
+  const QRect m_rect;
+  const QPoint m_offset;
+  const double m_scale;
+};
+
 class FilenamePatternValidator : public QValidator
 {
 public:
@@ -201,15 +252,23 @@ const View* ExportDialog::view() const
   return type_cast<View*>(kind_cast<Object*>(m_ui->cb_view->value()));
 }
 
-void ExportDialog::render(Scene& scene, const View* view, QPaintDevice& device, double scale)
+ExportDialog::Recording ExportDialog::record(Scene& scene, const View* view, QPaintDevice& device)
 {
-  QPicture picture;
+  Recording recording;
   {
-    QPainter painter(&picture);
-    painter.setRenderHint(QPainter::Antialiasing);
+    std::unique_ptr<QPainter> painter;
+    const auto begin_picture = [&recording, &painter]() {
+      painter.reset();  // finish the current picture before the vector reallocates.
+      painter = std::make_unique<QPainter>(&recording.emplace_back());
+      painter->setRenderHint(QPainter::Antialiasing);
+      return painter.get();
+    };
 
     Painter renderer(scene, Painter::Category::Objects);
-    renderer.painter = &painter;
+    renderer.painter = begin_picture();
+    renderer.begin_object = [&renderer, &begin_picture]() {
+      renderer.set_painter(*begin_picture());
+    };
 
     const auto transformation = [&device, view](){
       if (view == nullptr) {
@@ -231,10 +290,103 @@ void ExportDialog::render(Scene& scene, const View* view, QPaintDevice& device,
     Painter::Options options(device);
     renderer.render(options);
   }
+  return recording;
+}
 
+void ExportDialog::render(Scene& scene, const View* view, QPaintDevice& device, double scale)
+{
+  const Recording recording = record(scene, view, device);
   QPainter final_painter(&device);
   final_painter.scale(scale, scale);
-  final_painter.drawPicture(QPointF(0.0, 0.0), picture);
+  for (const QPicture& picture : recording) {
+    final_painter.drawPicture(QPointF(0.0, 0.0), picture);
+  }
+}
+
+void ExportDialog::render(Scene& scene, const View* view, QImage& image, double scale)
+{
+  replay(record(scene, view, image), image, QPoint(0, 0), scale);
+}
+
+bool ExportDialog::render_png(Scene& scene, const View* view, const QSize& size,
+                              const QString& filename)
+{
+  // the picture only provides the size of the image to `record`, it is never painted on.
+  QPicture device;
+  device.setBoundingRect(QRect(QPoint(0, 0), size));
+  const Recording recording = record(scene, view, device);
+
+  PngWriter writer(filename, size);
+  for (int y = 0; y < size.height(); y += BAND_HEIGHT) {
+    QImage band(size.width(), std::min(BAND_HEIGHT, size.height() - y),
+                QImage::Format_ARGB32_Premultiplied);
+    band.fill(Qt::transparent);
+    replay(recording, band, QPoint(0, y), 1.0);
+    if (!writer.write(band)) {
+      return false;
+    }
+  }
+  return writer.finish();
+}
+
+bool ExportDialog::requires_streaming(const QSize& size, const QString& filename)
+{
+  return static_cast<qint64>(size.width()) * size.height() > MAX_IN_MEMORY_PIXELS
+      && QFileInfo(filename).suffix().compare("png", Qt::CaseInsensitive) == 0;
+}
+
+void ExportDialog::replay(const Recording& recording, QImage& image, const QPoint& offset,
+                          double scale)
+{
+  if (image.width() <= TILE_SIZE && image.height() <= TILE_SIZE) {
+    QPainter final_painter(&image);
+    final_painter.translate(-offset);
+    final_painter.scale(scale, scale);
+    for (const QPicture& picture : recording) {
+      final_painter.drawPicture(QPointF(0.0, 0.0), picture);
+    }
+    return;
+  }
+
+  // index the pictures by their bounds, such that each tile only replays the pictures which
+  // intersect it. The margin accounts for antialiasing.
+  using Index = BoundingVolumeHierarchy<std::size_t>;
+  std::vector<Index::Item> items;
+  std::vector<QByteArray> pictures;
+  items.reserve(recording.size());
+  pictures.reserve(recording.size());
+  for (const QPicture& picture : recording) {
+    // pictures without drawing, e.g., the one recorded before the first object, are skipped.
+    if (picture.boundingRect().isValid()) {
+      const QRectF bounding_rect = QTransform::fromScale(scale, scale)
+                                   .mapRect(QRectF(picture.boundingRect()))
+                                   .adjusted(-2.0, -2.0, 2.0, 2.0);
+      items.push_back({ BoundingBox(bounding_rect), pictures.size() });
+      pictures.emplace_back(picture.data(), static_cast<int>(picture.size()));
+    }
+  }
+  const Index index(std::move(items));
+
+  // detach the image before the tiles write into its memory concurrently.
+  uchar* const bits = image.bits();
+  QThreadPool pool;
+  for (int y = 0; y < image.height(); y += TILE_SIZE) {
+    for (int x = 0; x < image.width(); x += TILE_SIZE) {
+      const QRect rect = QRect(x, y, TILE_SIZE, TILE_SIZE).intersected(image.rect());
+      auto indices = index.query(BoundingBox(QRectF(rect.translated(offset))));
+      if (!indices.empty()) {
+        // keep the drawing order.
+        std::sort(indices.begin(), indices.end());
+        std::vector<QByteArray> tile_pictures;
+        tile_pictures.reserve(indices.size());
+        for (const std::size_t i : indices) {
+          tile_pictures.push_back(pictures[i]);
+        }
+        pool.start(new TileRenderer(std::move(tile_pictures), bits, image, rect, offset, scale));
+      }
+    }
+  }
+  pool.waitForDone();
 }
 
 void ExportDialog::save_as_raster()
@@ -252,12 +404,18 @@ void ExportDialog::save_as_raster()
     assert(filenames.size() == 1);
     const auto filename = filenames.front();
 
-    QImage image(m_ui->ne_resolution_x->value(),
-                 m_ui->ne_resolution_y->value(),
-                 QImage::Format_ARGB32_Premultiplied);
-    image.fill(Qt::transparent);
-    render(m_scene, view(), image);
-    if (image.save(filename)) {
+    const QSize size(m_ui->ne_resolution_x->value(), m_ui->ne_resolution_y->value());
+    const bool success = [this, size, filename]() {
+      if (requires_streaming(size, filename)) {
+        return render_png(m_scene, view(), size, filename);
+      } else {
+        QImage image(size, QImage::Format_ARGB32_Premultiplied);
+        image.fill(Qt::transparent);
+        render(m_scene, view(), image);
+        return image.save(filename);
+      }
+    }();
+    if (success) {
       m_filepath = filename;
     } else {
       const auto msg = tr("Writing image '%1' failed.").arg(filename);
@@ -375,22 +533,47 @@ void ExportDialog::start_export_animation()
     m_animation_directory = path;
     const QString pattern = m_ui->le_pattern->text();
     const bool allow_overwrite = m_ui->cb_overwrite->isChecked();
-    for (int frame = m_ui->sb_start->value(); frame <= m_ui->sb_end->value(); ++frame) {
+    const int start = m_ui->sb_start->value();
+    const int end = m_ui->sb_end->value();
+
+    // the frames are encoded in the background while the next ones are evaluated.
+    ImageWriter writer;
+    QProgressBar& progress_bar = *m_ui->progress_bar;
+    progress_bar.setRange(0, end - start + 1);
+    progress_bar.setValue(0);
+    progress_bar.setVisible(true);
+    const auto advance_progress = [&progress_bar]() {
+      progress_bar.setValue(progress_bar.value() + 1);
+    };
+    connect(&writer, &ImageWriter::written, &progress_bar,
+            [advance_progress](const QString& filename, bool success)
+    {
+      if (success) {
+        LINFO << "Wrote '" << filename << "'.";
+      }
+      advance_progress();
+    });
+
+    for (int frame = start; frame <= end; ++frame) {
       const QString filename = path + "/" + ExportDialog::filename(pattern, frame);
       if (QFileInfo().exists(filename) && !allow_overwrite) {
         LINFO << "Did not overwrite '" << filename << "'.";
+        advance_progress();
       } else {
         m_scene.animator().set_current(frame);
         QImage image(m_ui->ne_resolution_x->value(),
                      m_ui->ne_resolution_y->value(),
                      QImage::Format_ARGB32_Premultiplied);
-        if (image.save(filename)) {
-          LINFO << "Wrote '" << filename << "'.";
-        } else {
-          LWARNING << "Failed to write '" << filename << "'";
-        }
+        image.fill(Qt::transparent);
+        render(m_scene, view(), image);
+        writer.write(image, filename);
       }
+      // deliver the progress of the encoder threads.
+      QCoreApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
     }
+    writer.wait();
+    QCoreApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
+    progress_bar.setVisible(false);
   }
 }
 
@@ -2,6 +2,7 @@
 
 #include <QDialog>
 #include <memory>
+#include <vector>
 #include <QPicture>
 #include <QImage>
 
@@ -28,6 +29,43 @@ public:
 
   static void render(Scene& scene, const View* view, QPaintDevice& device, double scale = 1.0);
 
+  /**
+   * @brief render renders into @code image like the overload above, but large images are split
+   *  into tiles which are rasterized in parallel.
+   */
+  static void render(Scene& scene, const View* view, QImage& image, double scale = 1.0);
+  static constexpr int TILE_SIZE = 512;
+
+  /**
+   * @brief render_png renders into the PNG file @code filename band by band.
+   *  Only a band of `BAND_HEIGHT` rows is held in memory, hence the image size is not limited by
+   *  the available memory.
+   * @return true if the file has been written successfully.
+   */
+  static bool render_png(Scene& scene, const View* view, const QSize& size,
+                         const QString& filename);
+  static constexpr int BAND_HEIGHT = TILE_SIZE;
+
+  /**
+   * @brief requires_streaming returns whether an image of given @code size should be written
+   *  with `render_png` rather than be rendered into a `QImage`.
+   */
+  static bool requires_streaming(const QSize& size, const QString& filename);
+  static constexpr qint64 MAX_IN_MEMORY_PIXELS = 8192 * 8192;
+
+  /**
+   * @brief Recording holds the drawing of each object in a separate picture, in drawing order.
+   */
+  using Recording = std::vector<QPicture>;
+
+  /**
+   * @brief replay draws @code recording into @code image, which covers the rectangle at
+   *  @code offset of the whole rendering. Large images are split into tiles which are drawn in
+   *  parallel. Each tile replays only the pictures which intersect it.
+   */
+  static void replay(const Recording& recording, QImage& image, const QPoint& offset,
+                     double scale);
+
 protected:
   void resizeEvent(QResizeEvent* e) override;
   void showEvent(QShowEvent* e) override;
@@ -42,6 +80,8 @@ private:
   void save_as_raster();
   void save_as_svg();
   QPicture m_picture;
+
+  static Recording record(Scene& scene, const View* view, QPaintDevice& device);
   QString m_filepath;
   QString m_animation_directory;
   static QString filename(QString pattern, int frame_number);
@@ -0,0 +1,84 @@
+#include "mainwindow/imagewriter.h"
+#include <QMutexLocker>
+#include <QRunnable>
+#include <QThread>
+#include <algorithm>
+#include <limits>
+#include "logging.h"
+
+namespace omm
+{
+
+class ImageWriter::Task : public QRunnable
+{
+public:
+  Task(ImageWriter& writer, const QImage& image, const QString& filename, int units)
+    : m_writer(writer), m_image(image), m_filename(filename), m_units(units)
+  {
+  }
+
+  void run() override
+  {
+    const bool success = m_image.save(m_filename);
+    if (!success) {
+      // logging is not thread-safe, the failures are reported in `ImageWriter::wait`.
+      QMutexLocker locker(&m_writer.m_mutex);
+      m_writer.m_failed_filenames.push_back(m_filename);
+    }
+    Q_EMIT m_writer.written(m_filename, success);
+    m_writer.m_slots.release(m_units);
+  }
+
+private:
+  ImageWriter& m_writer;
+  const QImage m_image;
+  const QString m_filename;
+  const int m_units;
+};
+
+ImageWriter::ImageWriter(int n_threads, qint64 budget)
+{
+  if (n_threads <= 0) {
+    n_threads = QThread::idealThreadCount();
+  }
+  if (budget <= 0) {
+    budget = DEFAULT_BUDGET;
+  }
+  m_capacity = static_cast<int>(std::clamp<qint64>(budget / BUDGET_UNIT, 1,
+                                                   std::numeric_limits<int>::max()));
+  m_pool.setMaxThreadCount(n_threads);
+  m_slots.release(m_capacity);
+}
+
+ImageWriter::~ImageWriter()
+{
+  m_pool.waitForDone();
+}
+
+void ImageWriter::write(const QImage& image, const QString& filename)
+{
+  const int units = this->units(image);
+  m_slots.acquire(units);
+  m_pool.start(new Task(*this, image, filename, units));
+}
+
+int ImageWriter::units(const QImage& image) const
+{
+  const qint64 bytes = static_cast<qint64>(image.bytesPerLine()) * image.height();
+  const qint64 units = (bytes + BUDGET_UNIT - 1) / BUDGET_UNIT;
+  return static_cast<int>(std::clamp<qint64>(units, 1, m_capacity));
+}
+
+bool ImageWriter::wait()
+{
+  m_pool.waitForDone();
+  QMutexLocker locker(&m_mutex);
+  for (const QString& filename : m_failed_filenames) {
+    LWARNING << "Failed to write '" << filename << "'.";
+  }
+  const bool success = m_failed_filenames.isEmpty();
+  m_failed_filenames.clear();
+  return success;
+}
+
+}  // namespace omm
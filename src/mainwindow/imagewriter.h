@@ -0,0 +1,64 @@
+#pragma once
+
+#include <QImage>
+#include <QMutex>
+#include <QObject>
+#include <QSemaphore>
+#include <QStringList>
+#include <QThreadPool>
+
+namespace omm
+{
+
+/**
+ * @brief The ImageWriter class encodes and saves images on background threads, such that the
+ *  next frame can be evaluated and rendered while the previous ones are being encoded.
+ *  The memory of the images in flight is bounded: `write` blocks until enough of them are saved
+ *  if the budget is exhausted. An image which exceeds the whole budget is admitted alone.
+ */
+class ImageWriter : public QObject
+{
+  Q_OBJECT
+public:
+  /**
+   * @param n_threads the number of encoder threads. Defaults to the number of cores.
+   * @param budget the maximal number of bytes of the images in flight. Defaults to
+   *  `DEFAULT_BUDGET`, independent of the number of cores.
+   */
+  explicit ImageWriter(int n_threads = 0, qint64 budget = 0);
+  static constexpr qint64 DEFAULT_BUDGET = 256 * 1024 * 1024;
+  ~ImageWriter() override;
+
+  /**
+   * @brief write enqueues @code image to be saved as @code filename.
+   *  @code image must not be modified afterwards, which is trivially true since `QImage` is
+   *  implicitly shared.
+   */
+  void write(const QImage& image, const QString& filename);
+
+  /**
+   * @brief wait blocks until all enqueued images are saved and logs those which failed.
+   * @return true if all images since the last call have been saved successfully.
+   */
+  bool wait();
+
+Q_SIGNALS:
+  /**
+   * @brief written is emitted from an encoder thread when an image has been saved or failed to
+   *  be saved.
+   */
+  void written(const QString& filename, bool success);
+
+private:
+  class Task;
+  QThreadPool m_pool;
+  // the budget is counted in units of `BUDGET_UNIT` bytes, `QSemaphore` counts with `int`.
+  static constexpr qint64 BUDGET_UNIT = 1024;
+  int m_capacity;
+  QSemaphore m_slots;
+  int units(const QImage& image) const;
+  QMutex m_mutex;
+  QStringList m_failed_filenames;
+};
+
+}  // namespace omm
@@ -11,6 +11,8 @@
 #include "python/pythonengine.h"
 #include "scene/messagebox.h"
 #include "tools/toolbox.h"
+#include "objects/object.h"
+#include "logging.h"
 
 namespace
 {
@@ -46,6 +48,19 @@ template<typename... VecTs> auto max(const VecTs&... vecs)
   return fold<VecT::max>(vecs...);
 }
 
+/**
+ * @brief compute_culling_bounds grows the viewport bounds by a margin.
+ *  The scene bounding box of an object covers its geometry only. Pens, markers and handles might
+ *  exceed it, hence objects slightly outside of the viewport must not be culled.
+ */
+omm::BoundingBox compute_culling_bounds(const std::pair<omm::Vec2f, omm::Vec2f>& viewport_bounds)
+{
+  static constexpr double relative_margin = 0.5;
+  const auto& [min, max] = viewport_bounds;
+  const omm::Vec2f margin = (max - min) * relative_margin;
+  return omm::BoundingBox(min - margin, max + margin);
+}
+
 }  // namespace
 
 namespace omm
@@ -149,8 +164,16 @@ void Viewport::paintEvent(QPaintEvent*)
   m_scene.object_tree().root().set_transformation(viewport_transformation);
 
   Painter::Options options(*this);
+  options.culling_bounds = compute_culling_bounds(viewport_bounds);
   m_renderer.render(options);
 
+#ifndef NDEBUG
+  if (auto& n = Object::CachedGeomPathVectorGetter::n_recomputations; n > 0) {
+    LDEBUG << "Recomputed geometry " << n << " times during frame.";
+    n = 0;
+  }
+#endif  // NDEBUG
+
   auto& tool = m_scene.tool_box().active_tool();
   tool.viewport_transformation = viewport_transformation;
   tool.draw(m_renderer);
@@ -113,7 +113,8 @@ void CurveManagerWidget::mouseMoveEvent(QMouseEvent* event)
     variant_type& vv = new_knot->offset(m_dragged_tangent.side);
     const double new_offset = get_channel_value(vv, key.channel) + diff;
     set_channel_value(vv, key.channel, new_offset);
-    m_scene.submit<ChangeKeyFrameCommand>(key.frame, key.track.property(), std::move(new_knot));
+    m_scene.submit<ChangeKeyFrameCommand>(m_scene.animator(), key.frame, key.track.property(),
+                                          std::move(new_knot));
   } else if (m_key_being_dragged) {
     m_frame_shift = std::round(  frame_range.pixel_to_unit(event->x())
                                - frame_range.pixel_to_unit(m_mouse_down_pos.x()));
@@ -198,7 +199,7 @@ void CurveManagerWidget::mouseReleaseEvent(QMouseEvent* event)
           const double new_value = (key.value() + m_value_shift) / multiplier(key.track);
           auto new_knot = key.track.knot(key.frame).clone();
           set_channel_value(new_knot->value, key.channel, new_value);
-          m_scene.submit<ChangeKeyFrameCommand>(key.frame, property, std::move(new_knot));
+          m_scene.submit<ChangeKeyFrameCommand>(animator, key.frame, property, std::move(new_knot));
         }
       }
 
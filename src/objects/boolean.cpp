@@ -77,6 +77,9 @@ Flag Boolean::flags() const
 
 void Boolean::update()
 {
+  if (defer_update()) {
+    return;
+  }
   m_draw_children = !is_active();
   AbstractProceduralPath::update();
 }
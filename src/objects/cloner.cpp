@@ -13,9 +13,12 @@
 #include "python/scenewrapper.h"
 #include "python/objectwrapper.h"
 #include "python/pythonengine.h"
+#include <pybind11/numpy.h>
 #include "objects/empty.h"
 #include "scene/messagebox.h"
 #include <random>
+#include <iterator>
+#include <optional>
 
 namespace
 {
@@ -28,6 +31,14 @@ copy.set("rotation", id*math.pi/10.0)
 copy.set("scale", np.random.random(2)+0.5)
 )";
 
+constexpr auto default_batch_script = R"(import math
+import numpy as np
+np.random.seed(0)
+position = np.stack([ ids*100.0, np.zeros(count) ], axis=1)
+rotation = ids*math.pi/10.0
+scale = np.random.random((count, 2))+0.5
+)";
+
 constexpr auto max = std::numeric_limits<int>::max();
 
 }  // namespace
@@ -44,7 +55,7 @@ Cloner::Cloner(Scene* scene) : Object(scene)
   mode_property.set_options({ QObject::tr("Linear"),
     QObject::tr("Grid"), QObject::tr("Radial"),
     QObject::tr("Path"), QObject::tr("Script"),
-    QObject::tr("Fill Random") })
+    QObject::tr("Fill Random"), QObject::tr("Script (batch)") })
     .set_label(QObject::tr("mode"))
     .set_category(category);
 
@@ -98,6 +109,11 @@ Cloner::Cloner(Scene* scene) : Object(scene)
     .set_label(QObject::tr("code"))
     .set_category(category);
 
+  create_property<StringProperty>(BATCH_CODE_PROPERTY_KEY, default_batch_script)
+    .set_mode(StringProperty::Mode::Code)
+    .set_label(QObject::tr("code"))
+    .set_category(category);
+
   create_property<IntegerProperty>(SEED_PROPERTY_KEY, 12345)
     .set_label(QObject::tr("seed")).set_category(category);
 
@@ -113,17 +129,39 @@ Cloner::Cloner(const Cloner &other) : Object(other)
   polish();
 }
 
+Cloner::~Cloner()
+{
+  if (Scene* scene = this->scene(); scene != nullptr) {
+    scene->python_engine.invalidate_cache(this);
+  }
+}
+
 void Cloner::polish()
 {
   listen_to_changes([this]() {
     const Property* property = this->property(PATH_REFERENCE_PROPERTY_KEY);
     return kind_cast<Object*>(property->value<AbstractPropertyOwner*>());
   });
+
   listen_to_children_changes();
   update_property_visibility(property(MODE_PROPERTY_KEY)->value<Mode>());
   update();
 }
 
+void Cloner::on_dependency_changed(Object& dependency, DependencyGraph::Change change)
+{
+  // changes of the path only require to place the clones again.
+  if (&dependency != this && is_ancestor_of(dependency)) {
+    if (change == DependencyGraph::Change::Transformation) {
+      // the transformation of the direct children is re-applied to the clones in each update.
+      // Transformations of deeper descendants, however, are baked into the clones.
+      m_clones_are_dirty |= &dependency.tree_parent() != this;
+    } else {
+      m_clones_are_dirty = true;
+    }
+  }
+}
+
 void Cloner::draw_object(Painter &renderer, const Style& style, Painter::Options options) const
 {
   assert(&renderer.scene == scene());
@@ -170,10 +208,13 @@ bool Cloner::contains(const Vec2f &pos) const
 
 void Cloner::update()
 {
+  if (defer_update()) {
+    return;
+  }
   {
     QSignalBlocker blocker(&scene()->message_box());
     if (is_active()) {
-      m_clones = make_clones();
+      update_clones();
       m_draw_children = false;
     } else {
       m_clones.clear();
@@ -199,13 +240,19 @@ void Cloner::on_property_value_changed(Property *property)
       || property == this->property(END_PROPERTY_KEY)
       || property == this->property(ALIGN_PROPERTY_KEY)
       || property == this->property(BORDER_PROPERTY_KEY)
-      || property == this->property(CODE_PROPERTY_KEY)
       || property == this->property(SEED_PROPERTY_KEY)
       || property == this->property(ANCHOR_PROPERTY_KEY))
   {
     update();
+  } else if (   property == this->property(CODE_PROPERTY_KEY)
+             || property == this->property(BATCH_CODE_PROPERTY_KEY))
+  {
+    scene()->python_engine.invalidate_cache(this);
+    update();
   } else if (property == this->property(MODE_PROPERTY_KEY)) {
     update_property_visibility(property->value<Mode>());
+    // the clones may carry state of the previous mode, e.g., properties set by the script.
+    m_clones_are_dirty = true;
     update();
   } else {
     Object::on_property_value_changed(property);
@@ -215,20 +262,22 @@ void Cloner::on_property_value_changed(Property *property)
 void Cloner::on_child_added(Object &child)
 {
   Object::on_child_added(child);
+  m_clones_are_dirty = true;
   update();
 }
 
 void Cloner::on_child_removed(Object &child)
 {
   Object::on_child_removed(child);
+  m_clones_are_dirty = true;
   update();
 }
 
 void Cloner::update_property_visibility(Mode mode)
 {
   static const std::set<QString> properties {
-    CODE_PROPERTY_KEY, COUNT_PROPERTY_KEY, COUNT_2D_PROPERTY_KEY, DISTANCE_2D_PROPERTY_KEY,
-    RADIUS_PROPERTY_KEY, PATH_REFERENCE_PROPERTY_KEY, START_PROPERTY_KEY, END_PROPERTY_KEY,
+    CODE_PROPERTY_KEY, BATCH_CODE_PROPERTY_KEY, COUNT_PROPERTY_KEY, COUNT_2D_PROPERTY_KEY,
+    DISTANCE_2D_PROPERTY_KEY, RADIUS_PROPERTY_KEY, PATH_REFERENCE_PROPERTY_KEY, START_PROPERTY_KEY, END_PROPERTY_KEY,
     BORDER_PROPERTY_KEY, ALIGN_PROPERTY_KEY, SEED_PROPERTY_KEY, ANCHOR_PROPERTY_KEY
   };
   static const std::map<Mode, std::set<QString>> visibility_map {
@@ -239,6 +288,7 @@ void Cloner::update_property_visibility(Mode mode)
                     END_PROPERTY_KEY, ALIGN_PROPERTY_KEY, BORDER_PROPERTY_KEY,
                     ANCHOR_PROPERTY_KEY }},
     { Mode::Script, { COUNT_PROPERTY_KEY, CODE_PROPERTY_KEY }},
+    { Mode::BatchScript, { COUNT_PROPERTY_KEY, BATCH_CODE_PROPERTY_KEY }},
     { Mode::FillRandom, { COUNT_PROPERTY_KEY, PATH_REFERENCE_PROPERTY_KEY, SEED_PROPERTY_KEY,
                           ANCHOR_PROPERTY_KEY }},
     { Mode::Grid, { COUNT_2D_PROPERTY_KEY, DISTANCE_2D_PROPERTY_KEY }}
@@ -274,51 +324,51 @@ std::unique_ptr<Object> Cloner::convert() const
   return converted;
 }
 
-std::vector<std::unique_ptr<Object>> Cloner::make_clones()
+std::size_t Cloner::count() const
 {
-  const auto count = [this]() -> std::size_t {
-    switch (mode()) {
-    case Mode::Linear: [[fallthrough]];
-    case Mode::Radial: [[fallthrough]];
-    case Mode::Path: [[fallthrough]];
-    case Mode::Script: [[fallthrough]];
-    case Mode::FillRandom:
-      return static_cast<std::size_t>(property(COUNT_PROPERTY_KEY)->value<int>());
-    case Mode::Grid: {
-      const auto c = property(COUNT_2D_PROPERTY_KEY)->value<Vec2i>();
-      return static_cast<std::size_t>(c.x * c.y);
-    }
-    }
-    Q_UNREACHABLE();
-  };
+  switch (mode()) {
+  case Mode::Linear: [[fallthrough]];
+  case Mode::Radial: [[fallthrough]];
+  case Mode::Path: [[fallthrough]];
+  case Mode::Script: [[fallthrough]];
+  case Mode::BatchScript: [[fallthrough]];
+  case Mode::FillRandom:
+    return static_cast<std::size_t>(property(COUNT_PROPERTY_KEY)->value<int>());
+  case Mode::Grid: {
+    const auto c = property(COUNT_2D_PROPERTY_KEY)->value<Vec2i>();
+    return static_cast<std::size_t>(c.x * c.y);
+  }
+  }
+  Q_UNREACHABLE();
+}
 
-  const auto seed = property(SEED_PROPERTY_KEY)->value<int>();
-  std::random_device dev;
-  std::mt19937 rng(dev());
-  rng.seed(static_cast<decltype(rng)::result_type>(seed));
+void Cloner::update_clones()
+{
+  // The script may modify arbitrary properties of the clones, hence they cannot be reused.
+  if (m_clones_are_dirty || mode() == Mode::Script || n_children() == 0) {
+    m_clones.clear();
+    m_clones_are_dirty = false;
+  }
 
-  auto clones = copy_children(count());
-  for (std::size_t i = 0; i < clones.size(); ++i) {
-    switch (mode()) {
-    case Mode::Linear: set_linear(*clones[i], i); break;
-    case Mode::Radial: set_radial(*clones[i], i); break;
-    case Mode::Path: set_path(*clones[i], i); break;
-    case Mode::Script: set_by_script(*clones[i], i); break;
-    case Mode::Grid: set_grid(*clones[i], i); break;
-    case Mode::FillRandom: set_fillrandom(*clones[i], rng); break;
-    }
+  if (const auto count = n_children() == 0 ? 0 : this->count(); count < m_clones.size()) {
+    m_clones.erase(std::next(m_clones.begin(), static_cast<long>(count)), m_clones.end());
+  } else if (count > m_clones.size()) {
+    auto new_clones = copy_children(m_clones.size(), count);
+    m_clones.reserve(count);
+    std::move(new_clones.begin(), new_clones.end(), std::back_inserter(m_clones));
   }
 
-  return clones;
+  place_clones();
 }
 
-std::vector<std::unique_ptr<Object>> Cloner::copy_children(const std::size_t count)
+std::vector<std::unique_ptr<Object>> Cloner::copy_children(const std::size_t begin,
+                                                           const std::size_t end)
 {
   const auto n_children = this->n_children();
   std::vector<std::unique_ptr<Object>> clones;
-  if (n_children > 0 && count > 0) {
-    clones.reserve(count);
-    for (std::size_t i = 0; i < count; ++i) {
+  if (n_children > 0 && end > begin) {
+    clones.reserve(end - begin);
+    for (std::size_t i = begin; i < end; ++i) {
       auto clone = tree_child(i % n_children).clone();
       clone->set_virtual_parent(this);
       clone->update();
@@ -328,12 +378,45 @@ std::vector<std::unique_ptr<Object>> Cloner::copy_children(const std::size_t cou
   return clones;
 }
 
+void Cloner::place_clones()
+{
+  const auto seed = property(SEED_PROPERTY_KEY)->value<int>();
+  std::random_device dev;
+  std::mt19937 rng(dev());
+  rng.seed(static_cast<decltype(rng)::result_type>(seed));
+
+  const auto n_children = this->n_children();
+  for (std::size_t i = 0; i < m_clones.size(); ++i) {
+    Object& clone = *m_clones[i];
+    // the clone might have been placed before, hence start from the original transformation.
+    clone.set_transformation(tree_child(i % n_children).transformation());
+    switch (mode()) {
+    case Mode::Linear: set_linear(clone, i); break;
+    case Mode::Radial: set_radial(clone, i); break;
+    case Mode::Path: set_path(clone, i); break;
+    case Mode::Script: set_by_script(clone, i); break;
+    case Mode::Grid: set_grid(clone, i); break;
+    case Mode::FillRandom: set_fillrandom(clone, rng); break;
+    case Mode::BatchScript: break;
+    }
+  }
+
+  if (mode() == Mode::BatchScript && !m_clones.empty()) {
+    set_by_batch_script();
+  }
+}
+
 double Cloner::get_t(std::size_t i, const bool inclusive) const
 {
-  const auto n = property(COUNT_PROPERTY_KEY)->value<int>() + (inclusive ? 0 : 1);
-  const auto start = property(START_PROPERTY_KEY)->value<double>();
-  const auto end = property(END_PROPERTY_KEY)->value<double>();
-  const auto border = property(BORDER_PROPERTY_KEY)->value<Border>();
+  // get_t is called once per clone, hence the keys are interned.
+  static const PropertyKey count_key(COUNT_PROPERTY_KEY);
+  static const PropertyKey start_key(START_PROPERTY_KEY);
+  static const PropertyKey end_key(END_PROPERTY_KEY);
+  static const PropertyKey border_key(BORDER_PROPERTY_KEY);
+  const auto n = property_value<int>(count_key) + (inclusive ? 0 : 1);
+  const auto start = property_value<double>(start_key);
+  const auto end = property_value<double>(end_key);
+  const auto border = property_value<Border>(border_key);
 
   if (n <= 1) {
     return 0.0;
@@ -394,7 +477,70 @@ void Cloner::set_by_script(Object& object, std::size_t i)
                                 "copy"_a=ObjectWrapper::make(object),
                                 "this"_a=ObjectWrapper::make(*this),
                                 "scene"_a=SceneWrapper(*scene()) );
-  scene()->python_engine.exec(property(CODE_PROPERTY_KEY)->value<QString>(), locals, this);
+  auto& python_engine = scene()->python_engine;
+  const auto code = python_engine.compile(property(CODE_PROPERTY_KEY)->value<QString>(), this);
+  python_engine.exec(code, locals, this);
+}
+
+void Cloner::set_by_batch_script()
+{
+  namespace py = pybind11;
+  using namespace pybind11::literals;
+  using array_type = py::array_t<double, py::array::c_style | py::array::forcecast>;
+
+  const auto n = m_clones.size();
+  auto locals = py::dict( "ids"_a=py::module::import("numpy").attr("arange")(n),
+                          "count"_a=n,
+                          "this"_a=ObjectWrapper::make(*this),
+                          "scene"_a=SceneWrapper(*scene()) );
+  auto& python_engine = scene()->python_engine;
+  const auto code = python_engine.compile(property(BATCH_CODE_PROPERTY_KEY)->value<QString>(),
+                                          this);
+  if (!python_engine.exec(code, locals, this)) {
+    return;
+  }
+
+  // returns nothing if the script did not define `key` or if it has an unexpected shape.
+  const auto get_array = [&locals, n](const char* key,
+                                      std::size_t columns) -> std::optional<array_type>
+  {
+    if (!locals.contains(key)) {
+      return std::nullopt;
+    }
+    auto array = array_type::ensure(locals[key]);
+    const auto expected_ndim = columns == 1 ? 1 : 2;
+    if (   !array || array.ndim() != expected_ndim
+        || static_cast<std::size_t>(array.shape(0)) != n
+        || (expected_ndim == 2 && static_cast<std::size_t>(array.shape(1)) != columns))
+    {
+      LWARNING << "Ignoring '" << key << "': expected array with " << n << " rows and "
+               << columns << " column(s).";
+      return std::nullopt;
+    }
+    return array;
+  };
+
+  const auto position = get_array("position", 2);
+  const auto rotation = get_array("rotation", 1);
+  const auto scale = get_array("scale", 2);
+  const auto shear = get_array("shear", 1);
+
+  for (std::size_t i = 0; i < n; ++i) {
+    auto t = m_clones[i]->transformation();
+    if (position) {
+      t.set_translation(Vec2f(position->data()[2*i], position->data()[2*i + 1]));
+    }
+    if (rotation) {
+      t.set_rotation(rotation->data()[i]);
+    }
+    if (scale) {
+      t.set_scaling(Vec2f(scale->data()[2*i], scale->data()[2*i + 1]));
+    }
+    if (shear) {
+      t.set_shearing(shear->data()[i]);
+    }
+    m_clones[i]->set_transformation(t);
+  }
 }
 
 void Cloner::set_fillrandom(Object &object, std::mt19937& rng)
@@ -17,6 +17,7 @@ class Cloner : public Object
 public:
   explicit Cloner(Scene* scene);
   explicit Cloner(const Cloner& other);
+  ~Cloner();
   void draw_object(Painter& renderer, const Style& style, Painter::Options options) const override;
   BoundingBox bounding_box(const ObjectTransformation& transformation) const override;
   BoundingBox recursive_bounding_box(const ObjectTransformation& transformation) const override;
@@ -24,6 +25,7 @@ public:
   static constexpr auto TYPE = QT_TRANSLATE_NOOP("any-context", "Cloner");
   static constexpr auto MODE_PROPERTY_KEY = "mode";
   static constexpr auto CODE_PROPERTY_KEY = "code";
+  static constexpr auto BATCH_CODE_PROPERTY_KEY = "batch-code";
   static constexpr auto COUNT_PROPERTY_KEY = "count";
   static constexpr auto COUNT_2D_PROPERTY_KEY = "count2d";
   static constexpr auto DISTANCE_2D_PROPERTY_KEY = "distance2d";
@@ -36,7 +38,7 @@ public:
   static constexpr auto SEED_PROPERTY_KEY = "seed";
   static constexpr auto ANCHOR_PROPERTY_KEY = "anchor";
 
-  enum class Mode { Linear, Grid, Radial, Path, Script, FillRandom  };
+  enum class Mode { Linear, Grid, Radial, Path, Script, FillRandom, BatchScript };
   virtual Flag flags() const override;
   std::unique_ptr<Object> convert() const override;
   Mode mode() const;
@@ -46,13 +48,17 @@ public:
 
 protected:
   void on_property_value_changed(Property* property) override;
+  void on_dependency_changed(Object& dependency, DependencyGraph::Change change) override;
   void on_child_added(Object &child) override;
   void on_child_removed(Object &child) override;
   void update_property_visibility(Mode mode);
 
 private:
-  std::vector<std::unique_ptr<Object>> make_clones();
-  std::vector<std::unique_ptr<Object>> copy_children(const std::size_t n);
+  std::size_t count() const;
+  void update_clones();
+  std::vector<std::unique_ptr<Object>> copy_children(const std::size_t begin,
+                                                     const std::size_t end);
+  void place_clones();
 
   double get_t(std::size_t i, const bool inclusive) const;
   void set_linear(Object& object, std::size_t i);
@@ -60,8 +66,23 @@ private:
   void set_radial(Object& object, std::size_t i);
   void set_path(Object& object, std::size_t i);
   void set_by_script(Object& object, std::size_t i);
+
+  /**
+   * @brief set_by_batch_script runs the batch-script once for all clones.
+   *  The script gets the numpy-array `ids` and the number of clones `count`.
+   *  It may define the arrays `position` (count x 2), `rotation` (count), `scale` (count x 2)
+   *  and `shear` (count) which are written directly into the transformations of the clones.
+   */
+  void set_by_batch_script();
   void set_fillrandom(Object& object, std::mt19937 &rng);
   std::vector<std::unique_ptr<Object>> m_clones;
+
+  /**
+   * @brief m_clones_are_dirty is set if the structure of the children has changed.
+   *  The clones must be recreated from scratch then. Otherwise, existing clones are reused and
+   *  only their placement is recomputed.
+   */
+  bool m_clones_are_dirty = true;
   std::set<Property*> m_clone_dependencies;
   void polish();
 };
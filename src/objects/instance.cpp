@@ -72,7 +72,7 @@ BoundingBox Instance::bounding_box(const ObjectTransformation &transformation) c
   if (!cycle_guard->inside_cycle() && is_active()) {
     const auto* r = illustrated_object();
     if (r != nullptr) {
-      return r->recursive_bounding_box(transformation);
+      return r->recursive_bounding_box(transformation.apply(r->transformation()));
     } else {
       return BoundingBox();
     }
@@ -126,6 +126,9 @@ void Instance::post_create_hook()
 
 void Instance::update()
 {
+  if (defer_update()) {
+    return;
+  }
   auto cycle_guard = scene()->make_cycle_guard(this);
   if (cycle_guard->inside_cycle()) {
     return;
@@ -150,7 +153,7 @@ void Instance::update()
 Geom::PathVector Instance::paths() const
 {
   if (m_reference) {
-    return m_reference->paths();
+    return m_reference->geom_paths();
   } else {
     return Geom::PathVector();
   }
@@ -25,14 +25,19 @@
 #include "objects/path.h"
 #include "scene/scene.h"
 #include "scene/messagebox.h"
+#include "animation/animator.h"
 
 namespace
 {
 
 static constexpr auto almost_one = 0.9999999;
-static constexpr auto CHILDREN_POINTER = "children";
-static constexpr auto TAGS_POINTER = "tags";
-static constexpr auto TYPE_POINTER = "type";
+
+// the properties which are read whenever an object is drawn or transformed.
+const omm::PropertyKey position_key(omm::Object::POSITION_PROPERTY_KEY);
+const omm::PropertyKey scale_key(omm::Object::SCALE_PROPERTY_KEY);
+const omm::PropertyKey rotation_key(omm::Object::ROTATION_PROPERTY_KEY);
+const omm::PropertyKey shear_key(omm::Object::SHEAR_PROPERTY_KEY);
+const omm::PropertyKey is_active_key(omm::Object::IS_ACTIVE_PROPERTY_KEY);
 
 QPen make_bounding_box_pen()
 {
@@ -48,44 +53,11 @@ omm::Point geom_to_point(const Geom::Point& point)
   return omm::Point({point.x(), point.y()});
 }
 
-double length(const Geom::Curve& curve)
-{
-  return curve.length();
-}
-
-double length(const Geom::Path& path)
-{
-  return std::accumulate(path.begin(), path.end(), 0.0, [](double l, const Geom::Curve& curve) {
-    return l + curve.length();
-  });
-}
-
-template<typename Geometry>
-std::pair<std::size_t, double> factor_time_by_distance(const Geometry& geom, double t)
+void invalidate_scene_bounding_box_recursively(omm::Object& object)
 {
-  if (const auto n = geom.size(); n == 0) {
-    return {0, 0.0};
-  } else {
-    std::vector<double> accumulated_lengths;
-    accumulated_lengths.reserve(n+1);
-    double accu = 0.0;
-    accumulated_lengths.push_back(accu);
-    for (auto it = geom.begin(); it != geom.end(); ++it) {
-      accu += length(*it);
-      accumulated_lengths.push_back(accu);
-    }
-
-    t *= accumulated_lengths.back();
-    const auto segment_end = std::find_if(accumulated_lengths.begin(), accumulated_lengths.end(),
-                                          [t](double l) { return l > t; });
-    if (segment_end == accumulated_lengths.begin()) {
-      return {0, 0.0};
-    } else {
-      const auto segment_begin = std::next(segment_end, -1);
-      t -= *segment_begin;
-      t /= *segment_end - *segment_begin;
-      return {std::distance(accumulated_lengths.begin(), segment_begin), t};
-    }
+  object.scene_bounding_box.invalidate();
+  for (std::size_t i = 0; i < object.n_children(); ++i) {
+    invalidate_scene_bounding_box_recursively(object.tree_child(i));
   }
 }
 
@@ -95,12 +67,16 @@ namespace omm
 {
 
 QPen Object::m_bounding_box_pen = make_bounding_box_pen();
+std::size_t Object::CachedGeomPathVectorGetter::n_recomputations = 0;
 QBrush Object::m_bounding_box_brush = Qt::NoBrush;
 
 Object::Object(Scene* scene)
   : PropertyOwner(scene)
   , painter_path(*this)
   , geom_paths(*this)
+  , arc_length_table(*this)
+  , scene_bounding_box(*this)
+  , styles(*this)
   , tags(*this)
 {
   static const auto category = QObject::tr("basic");
@@ -149,6 +125,9 @@ Object::Object(const Object& other)
   , TreeElement(other)
   , painter_path(*this)
   , geom_paths(*this)
+  , arc_length_table(*this)
+  , scene_bounding_box(*this)
+  , styles(*this)
   , tags(other.tags, *this)
   , m_draw_children(other.m_draw_children)
   , m_object_tree(other.m_object_tree)
@@ -164,36 +143,58 @@ Object::~Object()
     // the object must not be selected when it gets deleted.
     // Bad things will happen otherwise.
     assert(!::contains(scene->selection(), this));
+    scene->dependency_graph().remove(*this);
   }
 }
 
 ObjectTransformation Object::transformation() const
 {
   return ObjectTransformation(
-    property(POSITION_PROPERTY_KEY)->value<Vec2f>(),
-    property(SCALE_PROPERTY_KEY)->value<Vec2f>(),
-    property(ROTATION_PROPERTY_KEY)->value<double>(),
-    property(SHEAR_PROPERTY_KEY)->value<double>()
+    property_value<Vec2f>(position_key),
+    property_value<Vec2f>(scale_key),
+    property_value<double>(rotation_key),
+    property_value<double>(shear_key)
   );
 }
 
 ObjectTransformation Object::global_transformation(Space space) const
 {
-  if (m_virtual_parent != nullptr) {
-    return m_virtual_parent->global_transformation(space).apply(transformation());
-  } else if (is_root()) {
-    return transformation();
-  } else if (space == Space::Scene && tree_parent().is_root()) {
-    return transformation();
-  } else {
-    // TODO caching could gain some speed
-    //  invalidate cache if local transformation is set or parent changes
-    return tree_parent().global_transformation(space).apply(transformation());
+  const auto compute = [this, space]() {
+    if (m_virtual_parent != nullptr) {
+      return m_virtual_parent->global_transformation(space).apply(transformation());
+    } else if (is_root()) {
+      return transformation();
+    } else if (space == Space::Scene && tree_parent().is_root()) {
+      return transformation();
+    } else {
+      return tree_parent().global_transformation(space).apply(transformation());
+    }
+  };
+
+  if (m_is_virtual) {
+    return compute();
+  }
+
+  auto& cache = m_global_transformation_cache.at(static_cast<std::size_t>(space));
+  if (!cache) {
+    cache = compute();
+  }
+  return *cache;
+}
+
+void Object::invalidate_global_transformation_cache()
+{
+  for (auto& cache : m_global_transformation_cache) {
+    cache.reset();
+  }
+  for (std::size_t i = 0; i < n_children(); ++i) {
+    tree_child(i).invalidate_global_transformation_cache();
   }
 }
 
 void Object::set_transformation(const ObjectTransformation& transformation)
 {
+  const auto batch = scene()->dependency_graph().make_batch();
   property(POSITION_PROPERTY_KEY)->set(transformation.translation());
   property(SCALE_PROPERTY_KEY)->set(transformation.scaling());
   property(ROTATION_PROPERTY_KEY)->set(transformation.rotation());
@@ -240,6 +241,16 @@ void Object::transform(const ObjectTransformation& transformation)
 void Object::set_virtual_parent(const Object* parent)
 {
   m_virtual_parent = parent;
+  set_is_virtual(parent != nullptr);
+}
+
+void Object::set_is_virtual(bool is_virtual)
+{
+  m_is_virtual = is_virtual || m_virtual_parent != nullptr;
+  invalidate_global_transformation_cache();
+  for (std::size_t i = 0; i < n_children(); ++i) {
+    tree_child(i).set_is_virtual(m_is_virtual);
+  }
 }
 
 std::ostream& operator<<(std::ostream& ostream, const Object& object)
@@ -288,19 +299,22 @@ void Object::deserialize(AbstractDeserializer& deserializer, const Pointer& root
   PropertyOwner::deserialize(deserializer, root);
 
   const auto children_pointer = make_pointer(root, CHILDREN_POINTER);
-  size_t n_children = deserializer.array_size(children_pointer);
-  for (size_t i = 0; i < n_children; ++i) {
-    const auto child_pointer = make_pointer(children_pointer, i);
+  for (const auto& child_pointer : deserializer.accepted_objects(children_pointer)) {
     const auto child_type = deserializer.get_string(make_pointer(child_pointer, TYPE_POINTER));
     try {
       auto child = Object::make(child_type, static_cast<Scene*>(scene()));
       child->set_object_tree(scene()->object_tree());
       child->deserialize(deserializer, child_pointer);
 
-      // TODO adopt sets the global transformation which is reverted by setting the local
-      //  transformation immediately afterwards. That can be optimized.
-      const auto t = child->transformation();
-      adopt(std::move(child)).set_transformation(t);
+      // the stored transformation is local already. `Object::adopt` would preserve the global
+      // transformation instead, which must be reverted afterwards.
+      Object& adoptee = TreeElement<Object>::adopt(std::move(child), n_children());
+      if (m_is_virtual) {
+        adoptee.set_is_virtual(true);
+      } else {
+        // caches may have been filled while `adoptee` was a root.
+        adoptee.invalidate_global_transformation_cache();
+      }
     } catch (std::out_of_range&) {
       const auto message = QObject::tr("Failed to retrieve object type '%1'.") .arg(child_type);
       LERROR << message;
@@ -324,17 +338,33 @@ void Object::deserialize(AbstractDeserializer& deserializer, const Pointer& root
 
 void Object::draw_recursive(Painter& renderer, Painter::Options options) const
 {
+  // Virtual objects (e.g., clones) are not notified when their virtual parent changes, hence their
+  // scene bounding box cannot be trusted. They are culled together with their virtual parent.
+  if (options.culling_bounds && !is_root() && !m_is_virtual) {
+    const auto& box = scene_bounding_box();
+    if (!box.is_empty() && !options.culling_bounds->intersects(box)) {
+      return;
+    }
+  }
+
   renderer.push_transformation(transformation());
   const bool is_enabled = !!(renderer.category_filter & Painter::Category::Objects);
   if (is_enabled && is_visible(options.device_is_viewport)) {
+    if (renderer.begin_object) {
+      renderer.begin_object();
+    }
+
     // TODO options.styles is overriden before being used. Why not use a local variable instead?
     // Remove the styles field from Painter::Options
-    options.styles = find_styles();
+    options.styles = styles();
     for (auto* style : options.styles) {
       draw_object(renderer, *style, options);
     }
     if (options.styles.size() == 0) {
       draw_object(renderer, *options.default_style, options);
+      prune_display_lists({ options.default_style });
+    } else {
+      prune_display_lists(options.styles);
     }
 
     if (!!(renderer.category_filter & Painter::Category::BoundingBox)) {
@@ -367,6 +397,23 @@ BoundingBox Object::bounding_box(const ObjectTransformation& transformation) con
   }
 }
 
+BoundingBox Object::CachedSceneBoundingBoxGetter::compute() const
+{
+  return m_self.recursive_bounding_box(m_self.global_transformation(Space::Scene));
+}
+
+void Object::invalidate_scene_bounding_box(bool include_descendants)
+{
+  if (include_descendants) {
+    for (std::size_t i = 0; i < n_children(); ++i) {
+      invalidate_scene_bounding_box_recursively(tree_child(i));
+    }
+  }
+  for (Object* o = this; o != nullptr; o = o->is_root() ? nullptr : &o->tree_parent()) {
+    o->scene_bounding_box.invalidate();
+  }
+}
+
 BoundingBox Object::recursive_bounding_box(const ObjectTransformation& transformation) const
 {
   BoundingBox bounding_box;
@@ -383,6 +430,7 @@ std::unique_ptr<Object> Object::repudiate(Object &repudiatee)
 {
   const auto global_transformation = repudiatee.global_transformation(Space::Scene);
   auto o = TreeElement<Object>::repudiate(repudiatee);
+  repudiatee.set_is_virtual(false);
   repudiatee.set_global_transformation(global_transformation, Space::Scene);
   return o;
 }
@@ -391,6 +439,7 @@ Object &Object::adopt(std::unique_ptr<Object> adoptee, const size_t pos)
 {
   const auto global_transformation = adoptee->global_transformation(Space::Scene);
   Object& o = TreeElement<Object>::adopt(std::move(adoptee), pos);
+  o.set_is_virtual(m_is_virtual);
   o.set_global_transformation(global_transformation, Space::Scene);
   return o;
 }
@@ -418,6 +467,7 @@ void Object::copy_tags(Object& other) const
 
 void Object::on_property_value_changed(Property *property)
 {
+  invalidate_display_lists();
   const auto object_tree_data_changed = [this](int column) {
     if (m_object_tree != nullptr) {
       const auto index = m_object_tree->index_of(*this).siblingAtColumn(column);
@@ -430,6 +480,11 @@ void Object::on_property_value_changed(Property *property)
       || property == this->property(SHEAR_PROPERTY_KEY)
       || property == this->property(SCALE_PROPERTY_KEY) )
   {
+    invalidate_global_transformation_cache();
+
+    // `transformation_changed` forwards to `appearance_changed(tree_parent())`.
+    // The dependents shall be updated only once.
+    const auto batch = scene()->dependency_graph().make_batch();
     Q_EMIT scene()->message_box().transformation_changed(*this);
   } else if (property == this->property(IS_ACTIVE_PROPERTY_KEY)) {
     object_tree_data_changed(ObjectTree::VISIBILITY_COLUMN);
@@ -455,8 +510,13 @@ void Object::post_create_hook() { }
 
 void Object::update()
 {
+  if (defer_update()) {
+    return;
+  }
   painter_path.invalidate();
   geom_paths.invalidate();
+  arc_length_table.invalidate();
+  invalidate_display_lists();
   if (Scene* scene = this->scene(); scene != nullptr) {
     Q_EMIT scene->message_box().appearance_changed(*this);
   }
@@ -500,7 +560,7 @@ void Object::set_oriented_position(const Point& op, const bool align)
   set_global_transformation(transformation, Space::Viewport);
 }
 
-bool Object::is_active() const { return property(IS_ACTIVE_PROPERTY_KEY)->value<bool>(); }
+bool Object::is_active() const { return property_value<bool>(is_active_key); }
 
 bool Object::is_visible(bool viewport) const
 {
@@ -544,6 +604,11 @@ std::vector<const omm::Style*> Object::find_styles() const
   return ::filter_if(::transform<const omm::Style*>(tags, get_style), ::is_not_null);
 }
 
+std::vector<const Style*> Object::CachedStylesGetter::compute() const
+{
+  return m_self.find_styles();
+}
+
 Point Object::pos(const Geom::PathVectorTime& t) const
 {
   auto&& paths = geom_paths();
@@ -585,8 +650,7 @@ bool Object::is_closed() const
 
 bool Object::contains(const Vec2f &point) const
 {
-  Q_UNUSED(point)
-  return false;
+  return is_closed() && painter_path().contains(point.to_pointf());
 }
 
 Geom::PathVector Object::paths() const
@@ -598,7 +662,7 @@ Geom::PathVectorTime Object::compute_path_vector_time(double t,
                                                       Interpolation interpolation) const
 {
   t = std::clamp(t, 0.0, almost_one);
-  const auto path_vector = paths();
+  const auto& path_vector = geom_paths();
   if (path_vector.empty()) {
     return Geom::PathVectorTime(0, 0, 0.0);
   }
@@ -611,10 +675,7 @@ Geom::PathVectorTime Object::compute_path_vector_time(double t,
     return compute_path_vector_time(path_index, path_position, interpolation);
   }
   case Interpolation::Distance:
-  {
-    const auto [i, tp] = factor_time_by_distance(path_vector, t);
-    return compute_path_vector_time(i, tp, interpolation);
-  }
+    return arc_length_table().time(t);
   default:
     return {};
   }
@@ -624,12 +685,12 @@ Geom::PathVectorTime Object::compute_path_vector_time(std::size_t path_index, do
                                                       Interpolation interpolation) const
 {
   t = std::clamp(t, 0.0, almost_one);
-  const auto path_vector = paths();
+  const auto& path_vector = geom_paths();
   if (path_index >= path_vector.size()) {
     return Geom::PathVectorTime(path_index, 0, 0.0);
   }
 
-  const auto path = path_vector[path_index];
+  const auto& path = path_vector[path_index];
   if (path.empty()) {
     return Geom::PathVectorTime(path_index, 0, 0.0);
   }
@@ -642,10 +703,7 @@ Geom::PathVectorTime Object::compute_path_vector_time(std::size_t path_index, do
     return Geom::PathVectorTime(path_index, curve_index, curve_position);
   }
   case Interpolation::Distance:
-  {
-    const auto [i, tc] = factor_time_by_distance(path, t);
-    return Geom::PathVectorTime(path_index, i, tc);
-  }
+    return arc_length_table().time(path_index, t);
   default:
     return {};
   }
@@ -671,23 +729,64 @@ QString Object::tree_path() const
 void Object::draw_object(Painter& renderer, const Style& style, Painter::Options options) const
 {
   if (QPainter* painter = renderer.painter; painter != nullptr && is_active()) {
+    if (style.is_view_dependent()) {
+      record_object(renderer, style, options);
+      return;
+    }
+
+    DisplayList& display_list = m_display_lists[&style];
+    if (display_list.style_version != style.version()) {
+      display_list.picture = QPicture();
+      QPainter recorder(&display_list.picture);
+      renderer.painter = &recorder;
+      record_object(renderer, style, options);
+      renderer.painter = painter;
+      display_list.style_version = style.version();
+    }
+    painter->drawPicture(QPointF(0.0, 0.0), display_list.picture);
+  }
+}
+
+void Object::invalidate_display_lists()
+{
+  m_display_lists.clear();
+}
+
+void Object::prune_display_lists(const std::vector<const Style*>& styles) const
+{
+  for (auto it = m_display_lists.begin(); it != m_display_lists.end();) {
+    if (::contains(styles, it->first)) {
+      ++it;
+    } else {
+      it = m_display_lists.erase(it);
+    }
+  }
+}
+
+void Object::record_object(Painter& renderer, const Style& style,
+                           const Painter::Options& options) const
+{
+  if (QPainter* painter = renderer.painter; painter != nullptr) {
     if (const auto painter_path = this->painter_path(); !painter_path.isEmpty()) {
       renderer.set_style(style, *this, options);
       if (!is_closed()) {
         renderer.painter->setBrush(Qt::NoBrush);
       }
       painter->drawPath(painter_path);
-      const auto marker_color = style.property(Style::PEN_COLOR_KEY)->value<Color>();
-      const auto width = style.property(Style::PEN_WIDTH_KEY)->value<double>();
 
-      const auto paths = this->paths();
+      const Style::Resolved& resolved = style.resolved();
+      if (resolved.start_marker.is_empty() && resolved.end_marker.is_empty()) {
+        return;
+      }
+      const auto& paths = geom_paths();
       for (std::size_t path_index = 0; path_index < paths.size(); ++path_index) {
         const auto pos = [this, path_index](const double t) {
           const auto tt = compute_path_vector_time(path_index, t);
           return this->pos(tt).rotated(M_PI_2);
         };
-        style.start_marker.draw_marker(renderer, pos(0.0), marker_color, width);
-        style.end_marker.draw_marker(renderer, pos(1.0), marker_color, width);
+        const auto& color = resolved.pen_color;
+        MarkerProperties::draw_marker(renderer, pos(0.0), resolved.start_marker, color);
+        MarkerProperties::draw_marker(renderer, pos(1.0), resolved.end_marker, color);
       }
     }
   }
@@ -718,34 +817,39 @@ void Object::on_child_removed(Object &child)
 
 void Object::listen_to_changes(const std::function<Object *()> &get_watched)
 {
-  connect(&scene()->message_box(), qOverload<Object&>(&MessageBox::appearance_changed), this,
-          [get_watched, this](Object& o)
-  {
-    Object* r = get_watched();
-    if (r != nullptr) {
-      if (r->is_ancestor_of(*this)) {
-        {
-          QSignalBlocker blocker(&scene()->message_box());
-          update();
-        }
-        Q_EMIT scene()->message_box().appearance_changed();
-      } else if (r->is_ancestor_of(o)) {
-        update();
-      }
-    }
-  });
+  scene()->dependency_graph().add_reference_dependency(*this, get_watched);
 }
 
 void Object::listen_to_children_changes()
 {
-  const auto on_change = [this](Object& o) {
-    if (&o != this && is_ancestor_of(o)) {
-      update();
-    }
-  };
-  connect(&scene()->message_box(), &MessageBox::transformation_changed, this, on_change);
-  connect(&scene()->message_box(), qOverload<Object&>(&MessageBox::appearance_changed),
-          this, on_change);
+  scene()->dependency_graph().add_children_dependency(*this);
+}
+
+bool Object::is_frame_cacheable() const
+{
+  if (m_scene == nullptr || m_is_virtual) {
+    return false;
+  }
+  const Object* root = this;
+  while (!root->is_root()) {
+    root = &root->tree_parent();
+  }
+  return root == &m_scene->object_tree().root();
+}
+
+bool Object::defer_update()
+{
+  if (Scene* scene = this->scene(); scene != nullptr) {
+    return scene->dependency_graph().defer_update(*this);
+  } else {
+    return false;
+  }
+}
+
+void Object::on_dependency_changed(Object& dependency, DependencyGraph::Change change)
+{
+  Q_UNUSED(dependency)
+  Q_UNUSED(change)
 }
 
 Geom::Path Object::segment_to_path(Segment segment, bool is_closed,
@@ -798,7 +902,7 @@ Geom::Path Object::segment_to_path(Segment segment, bool is_closed,
 QPainterPath Object::CachedQPainterPathGetter::compute() const
 {
   static const auto qpoint = [](const Geom::Point& point) { return QPointF{point[0], point[1]}; };
-  const auto path_vector = m_self.paths();
+  const auto& path_vector = m_self.geom_paths();
   QPainterPath pp;
   for (const Geom::Path& path : path_vector) {
     pp.moveTo(qpoint(path.initialPoint()));
@@ -810,9 +914,26 @@ QPainterPath Object::CachedQPainterPathGetter::compute() const
   return pp;
 }
 
+ArcLengthTable Object::CachedArcLengthTableGetter::compute() const
+{
+  return ArcLengthTable(m_self.geom_paths());
+}
+
 Geom::PathVector Object::CachedGeomPathVectorGetter::compute() const
 {
-  return m_self.paths();
+  Animator* animator = m_self.is_frame_cacheable() ? &m_self.scene()->animator() : nullptr;
+  if (animator != nullptr) {
+    if (const Geom::PathVector* paths = animator->cached_geometry(m_self); paths != nullptr) {
+      return *paths;
+    }
+  }
+
+  n_recomputations += 1;
+  auto paths = m_self.paths();
+  if (animator != nullptr) {
+    animator->cache_geometry(m_self, paths);
+  }
+  return paths;
 }
 
 }  // namespace omm
@@ -2,6 +2,10 @@
 
 #include <vector>
 #include <memory>
+#include <array>
+#include <optional>
+#include <map>
+#include <QPicture>
 #include "external/json_fwd.hpp"
 #include "geometry/objecttransformation.h"
 #include "aspects/propertyowner.h"
@@ -13,6 +17,8 @@
 #include "geometry/point.h"
 #include "2geom/pathvector.h"
 #include "cachedgetter.h"
+#include "geometry/arclengthtable.h"
+#include "scene/dependencygraph.h"
 
 namespace omm
 {
@@ -87,13 +93,67 @@ public:
     QPainterPath compute() const override;
   } painter_path;
 
+  /**
+   * @brief geom_paths caches the result of `paths`. It is invalidated by `update`.
+   *  If the `FrameCache` is enabled, the result is cached per frame, too.
+   *  All geometry queries (drawing, markers, `compute_path_vector_time`, `contains`,
+   *  `bounding_box`, ...) shall read from this cache rather than calling `paths` directly.
+   */
   struct CachedGeomPathVectorGetter : CachedGetter<Geom::PathVector, Object>
   {
     using CachedGetter::CachedGetter;
+
+    /**
+     * @brief n_recomputations counts the recomputations of any object's geometry.
+     *  It is meant for debugging, the viewport reports and resets it after each frame.
+     */
+    static std::size_t n_recomputations;
   private:
     Geom::PathVector compute() const override;
   } geom_paths;
 
+  /**
+   * @brief arc_length_table caches the cumulative arc lengths of `geom_paths`.
+   *  It is used to sample the geometry by distance and is invalidated by `update`.
+   */
+  struct CachedArcLengthTableGetter : CachedGetter<ArcLengthTable, Object>
+  {
+    using CachedGetter::CachedGetter;
+  private:
+    ArcLengthTable compute() const override;
+  } arc_length_table;
+
+  /**
+   * @brief scene_bounding_box caches `recursive_bounding_box` in scene coordinates.
+   *  The viewport uses it to skip subtrees which are not visible.
+   *  It is invalidated by `invalidate_scene_bounding_box`, which the `Scene` calls on
+   *  `MessageBox::appearance_changed(Object&)` and `MessageBox::transformation_changed(Object&)`.
+   */
+  struct CachedSceneBoundingBoxGetter : CachedGetter<BoundingBox, Object>
+  {
+    using CachedGetter::CachedGetter;
+  private:
+    BoundingBox compute() const override;
+  } scene_bounding_box;
+
+  /**
+   * @brief styles caches `find_styles`. It is invalidated by the `TagList` when tags are inserted
+   *  or removed and by `StyleTag` when its style changes.
+   */
+  struct CachedStylesGetter : CachedGetter<std::vector<const Style*>, Object>
+  {
+    using CachedGetter::CachedGetter;
+  private:
+    std::vector<const Style*> compute() const override;
+  } styles;
+
+  /**
+   * @brief invalidate_scene_bounding_box invalidates the scene bounding box of this object and
+   *  its ancestors. If @code include_descendants is true, the scene bounding boxes of all
+   *  descendants are invalidated, too. That is required if the global transformation changed.
+   */
+  void invalidate_scene_bounding_box(bool include_descendants);
+
   friend struct CachedQPainterPathGetter;
 
   using Segment = std::vector<Point>;
@@ -131,6 +191,9 @@ public:
   static constexpr auto SHEAR_PROPERTY_KEY = "shear";
   static constexpr auto HIERARCHY_CHANGED = 1;
   static constexpr auto TAG_CHANGED = 2;
+  static constexpr auto CHILDREN_POINTER = "children";
+  static constexpr auto TAGS_POINTER = "tags";
+  static constexpr auto TYPE_POINTER = "type";
 
   enum class Border { Clamp, Wrap, Hide, Reflect };
   static double apply_border(double t, Border border);
@@ -150,11 +213,36 @@ protected:
   void on_property_value_changed(Property* property) override;
   void on_child_added(Object &child) override;
   void on_child_removed(Object &child) override;
+  /**
+   * @brief listen_to_changes updates this object if the object returned by @code get_watched,
+   *  its transformation or any of its descendants changes.
+   * @see DependencyGraph::add_reference_dependency
+   */
   void listen_to_changes(const std::function<Object*()>& get_watched);
+
+  /**
+   * @brief listen_to_children_changes updates this object if any descendant changes.
+   * @see DependencyGraph::add_children_dependency
+   */
   void listen_to_children_changes();
 
+  /**
+   * @brief on_dependency_changed is called by the `DependencyGraph` for each change of a
+   *  dependency (see `listen_to_changes` and `listen_to_children_changes`) before `update` is
+   *  called once for all changes of the batch.
+   */
+  virtual void on_dependency_changed(Object& dependency, DependencyGraph::Change change);
+
+  /**
+   * @brief defer_update returns true if the update of this object is deferred by a batch
+   *  (see `DependencyGraph::make_batch`). It will be updated when the batch ends.
+   *  Each implementation of `update` must return immediately in that case.
+   */
+  bool defer_update();
+
 private:
   friend class ObjectView;
+  friend class DependencyGraph;
 
 public:
   void set_object_tree(ObjectTree& object_tree);
@@ -165,18 +253,59 @@ private:
   ObjectTree* m_object_tree = nullptr;
   const Object* m_virtual_parent = nullptr;
 
+  /**
+   * @brief m_is_virtual is true if this or any ancestor has a virtual parent.
+   *  Virtual objects (e.g., clones) are not notified when their virtual parent moves, hence they
+   *  must not cache their global transformation.
+   */
+  bool m_is_virtual = false;
+  void set_is_virtual(bool is_virtual);
+
+  /**
+   * @brief is_frame_cacheable returns true if the geometry of this object may be stored in the
+   *  `FrameCache`. Virtual objects and objects outside the object tree are recreated frequently,
+   *  they are not cacheable.
+   */
+  bool is_frame_cacheable() const;
+
+  // the global transformation for each `Space`, see `global_transformation`.
+  mutable std::array<std::optional<ObjectTransformation>, 2> m_global_transformation_cache;
+
+  /**
+   * @brief invalidate_global_transformation_cache invalidates the cached global transformation
+   *  of this and all descendants.
+   */
+  void invalidate_global_transformation_cache();
+
 private:
   mutable bool m_visibility_cache_is_dirty = true;
   mutable bool m_visibility_cache_value;
   static QPen m_bounding_box_pen;
   static QBrush m_bounding_box_brush;
 
+  /**
+   * @brief The DisplayList struct holds the draw operations of `Object::draw_object` for a style,
+   *  recorded in object coordinates. It is replayed with the current transformation as long as
+   *  neither the object (see `invalidate_display_lists`) nor the style (see `Style::version`)
+   *  changes. The lists of styles which have not been drawn are dropped after each drawing (see
+   *  `prune_display_lists`), hence a removed or deleted style never leaves a stale key behind.
+   */
+  struct DisplayList
+  {
+    std::size_t style_version = 0;
+    QPicture picture;
+  };
+  mutable std::map<const Style*, DisplayList> m_display_lists;
+  void invalidate_display_lists();
+  void prune_display_lists(const std::vector<const Style*>& styles) const;
+  void record_object(Painter& renderer, const Style& style, const Painter::Options& options) const;
+
 protected:
   template<typename Iterable> static Geom::PathVector join(const Iterable& items)
   {
     Geom::PathVector paths;
     for (auto&& item : items) {
-      const auto cps = item->paths();
+      const auto& cps = item->geom_paths();
       paths.insert(paths.end(), cps.begin(), cps.end());
     }
     return paths;
@@ -26,6 +26,7 @@ class Style;
 
 Path::Path(Scene* scene)
   : Object(scene)
+  , point_index(*this)
 {
   static const auto category = QObject::tr("path");
 
@@ -39,6 +40,13 @@ Path::Path(Scene* scene)
   update();
 }
 
+Path::Path(const Path& other)
+  : Object(other)
+  , segments(other.segments)
+  , point_index(*this)
+{
+}
+
 BoundingBox Path::bounding_box(const ObjectTransformation &transformation) const
 {
   Q_UNUSED(transformation);
@@ -62,14 +70,7 @@ void Path::serialize(AbstractSerializer& serializer, const Pointer& root) const
     if (segments.size() == 0) {
       LWARNING << "Ignoring empty sub-path.";
     } else {
-      const auto pts_ptr = make_pointer(subpath_ptr, i);
-      serializer.start_array(segments.size(), pts_ptr);
-      std::size_t j = 0;
-      for (auto&& point : segments[i]) {
-        point.serialize(serializer, make_pointer(pts_ptr, j));
-        j += 1;
-        serializer.end_array();
-      }
+      serializer.set_points(segments[i], make_pointer(subpath_ptr, i));
     }
   }
   serializer.end_array();
@@ -84,25 +85,23 @@ void Path::deserialize(AbstractDeserializer& deserializer, const Pointer& root)
   segments.clear();
   segments.reserve(n_paths);
   for (size_t i = 0; i < n_paths; ++i) {
-    const auto pts_ptr = make_pointer(subpath_ptr, i);
-    const std::size_t n_points = deserializer.array_size(pts_ptr);
-    if (n_points == 0) {
+    auto points = deserializer.get_points(make_pointer(subpath_ptr, i));
+    if (points.empty()) {
       throw AbstractDeserializer::DeserializeError("Empty sub-paths are not allowed.");
     }
-    segments.push_back({});
-    for (size_t j = 0; j < n_points; ++j) {
-      Point p;
-      p.deserialize(deserializer, make_pointer(pts_ptr, j));
-      segments[i].push_back(p);
-    }
+    segments.push_back(std::move(points));
   }
   update();
 }
 
 void Path::update()
 {
+  if (defer_update()) {
+    return;
+  }
   painter_path.invalidate();
   geom_paths.invalidate();
+  point_index.invalidate();
   Object::update();
 }
 
@@ -145,6 +144,26 @@ std::size_t Path::count() const
   });
 }
 
+BoundingVolumeHierarchy<std::pair<std::size_t, std::size_t>>
+Path::CachedPointIndexGetter::compute() const
+{
+  using Index = BoundingVolumeHierarchy<std::pair<std::size_t, std::size_t>>;
+  std::vector<Index::Item> items;
+  items.reserve(3 * m_self.count());
+  for (std::size_t i = 0; i < m_self.segments.size(); ++i) {
+    const auto& segment = m_self.segments[i];
+    for (std::size_t j = 0; j < segment.size(); ++j) {
+      const Point& point = segment[j];
+      for (const Vec2f& position : { point.left_position(), point.position,
+                                     point.right_position() })
+      {
+        items.push_back({ BoundingBox(position, position), { i, j } });
+      }
+    }
+  }
+  return Index(std::move(items));
+}
+
 Path::iterator Path::end() { return ::omm::end<Path&>(*this); }
 Path::iterator Path::begin() { return ::omm::begin<Path&>(*this); }
 
@@ -5,6 +5,7 @@
 #include "geometry/point.h"
 #include <list>
 #include "cachedgetter.h"
+#include "geometry/boundingvolumehierarchy.h"
 #include <type_traits>
 
 namespace omm
@@ -16,6 +17,7 @@ class Path : public Object
 {
 public:
   explicit Path(Scene* scene);
+  Path(const Path& other);
   BoundingBox bounding_box(const ObjectTransformation& transformation) const override;
   QString type() const override;
 
@@ -34,6 +36,20 @@ public:
   std::vector<Segment> segments;
   std::size_t count() const;
 
+  /**
+   * @brief point_index indexes the points by their position and tangent tips in local
+   *  coordinates. The values are (segment, point)-pairs, i.e., `segments[segment][point]`.
+   *  A point is found if its position or one of its tangent tips is in the queried region.
+   *  It is invalidated by `update`.
+   */
+  struct CachedPointIndexGetter
+    : CachedGetter<BoundingVolumeHierarchy<std::pair<std::size_t, std::size_t>>, Path>
+  {
+    using CachedGetter::CachedGetter;
+  private:
+    BoundingVolumeHierarchy<std::pair<std::size_t, std::size_t>> compute() const override;
+  } point_index;
+
   template<typename PathRef>
   struct Iterator
   {
@@ -1,6 +1,9 @@
 #include "objects/proceduralpath.h"
 #include <QObject>
 #include <pybind11/stl.h>
+#include <pybind11/numpy.h>
+#include <cstddef>
+#include <algorithm>
 #include "properties/integerproperty.h"
 #include "properties/boolproperty.h"
 #include "objects/path.h"
@@ -14,20 +17,87 @@
 namespace
 {
 
-constexpr auto default_script = R"(import math
-import numpy as np
-
-for i, p in enumerate(points):
-  r = 50 if i % 2 else 200
-  theta = i/len(points)*math.pi*2
-  pos = np.array([math.cos(theta), math.sin(theta)])
-  tangent = np.array([pos[1], -pos[0]])
-  p.set_position(r*pos)
-  r /= 10
-  p.set_left_tangent(r*tangent)
-  p.set_right_tangent(-r*tangent)
+constexpr auto default_script = R"(import numpy as np
+
+n = len(point_buffer)
+i = np.arange(n)
+r = np.where(i % 2, 50.0, 200.0)
+theta = i/n*np.pi*2
+point_buffer["position"] = np.stack([ r*np.cos(theta), r*np.sin(theta) ], axis=1)
+# tangents are given in polar coordinates: [ argument, magnitude ]
+point_buffer["left_tangent"] = np.stack([ theta - np.pi/2, r/10 ], axis=1)
+point_buffer["right_tangent"] = np.stack([ theta + np.pi/2, r/10 ], axis=1)
 )";
 
+namespace py = pybind11;
+using PointRecord = omm::ProceduralPath::PointRecord;
+static_assert(std::is_standard_layout_v<PointRecord>);
+
+using PointBuffer = std::shared_ptr<std::vector<PointRecord>>;
+
+py::array make_point_buffer(const PointBuffer& points)
+{
+  const auto make_dtype = []() {
+    py::dict spec;
+    spec["names"] = py::cast(std::vector<std::string>{ "position", "left_tangent",
+                                                       "right_tangent", "is_selected" });
+    spec["formats"] = py::cast(std::vector<std::string>{ "(2,)f8", "(2,)f8", "(2,)f8", "?" });
+    spec["offsets"] = py::cast(std::vector<std::size_t>{ offsetof(PointRecord, position),
+                                                         offsetof(PointRecord, left_tangent),
+                                                         offsetof(PointRecord, right_tangent),
+                                                         offsetof(PointRecord, is_selected) });
+    spec["itemsize"] = sizeof(PointRecord);
+    return py::dtype::from_args(spec);
+  };
+
+  // the capsule shares the ownership of the points, hence the array stays valid if a script keeps
+  // it beyond the update (e.g., as global) while the path already uses a new buffer.
+  const py::capsule base(new PointBuffer(points), [](void* owner) {
+    delete static_cast<PointBuffer*>(owner);
+  });
+  return py::array(make_dtype(), { points->size() }, { sizeof(PointRecord) }, points->data(), base);
+}
+
+/**
+ * @brief references_name returns true if the compiled @code code refers to @code name.
+ *  Nested code objects (e.g., of functions or lambdas) are considered, too.
+ */
+bool references_name(const py::handle& code, const std::string& name)
+{
+  if (!py::hasattr(code, "co_names")) {
+    return false;
+  }
+  for (auto&& co_name : code.attr("co_names")) {
+    if (co_name.cast<std::string>() == name) {
+      return true;
+    }
+  }
+  for (auto&& co_const : code.attr("co_consts")) {
+    if (references_name(co_const, name)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+PointRecord to_record(const omm::Point& point)
+{
+  return PointRecord{ { point.position.x, point.position.y },
+                      { point.left_tangent.argument, point.left_tangent.magnitude },
+                      { point.right_tangent.argument, point.right_tangent.magnitude },
+                      point.is_selected };
+}
+
+Geom::Point cartesian(const double* position, const double* tangent = nullptr)
+{
+  if (tangent == nullptr) {
+    return Geom::Point(position[0], position[1]);
+  } else {
+    return Geom::Point(position[0] + tangent[1] * std::cos(tangent[0]),
+                       position[1] + tangent[1] * std::sin(tangent[0]));
+  }
+}
+
 }  // namespace
 
 namespace omm
@@ -49,45 +119,97 @@ ProceduralPath::ProceduralPath(Scene* scene) : Object(scene)
   update();
 }
 
+ProceduralPath::ProceduralPath(const ProceduralPath& other)
+  : Object(other)
+  , m_points(std::make_shared<std::vector<PointRecord>>(*other.m_points))
+{
+}
+
+ProceduralPath::~ProceduralPath()
+{
+  if (Scene* scene = this->scene(); scene != nullptr) {
+    scene->python_engine.invalidate_cache(this);
+  }
+}
 
 QString ProceduralPath::type() const { return TYPE; }
 
 void ProceduralPath::update()
 {
+  if (defer_update()) {
+    return;
+  }
   assert(scene() != nullptr);
   using namespace pybind11::literals;
   const auto count = property(COUNT_PROPERTY_KEY)->value<int>();
-  const auto code = property(CODE_PROPERTY_KEY)->value<QString>();
-
-  m_points = std::vector<Point>(static_cast<std::size_t>(std::max(0, count)));
-  std::vector<PointWrapper> point_wrappers;
-  point_wrappers.reserve(m_points.size());
-  for (Point& point : m_points) {
-    point_wrappers.emplace_back(point);
-  }
+  const auto n = static_cast<std::size_t>(std::max(0, count));
+  auto& python_engine = scene()->python_engine;
+  const auto code = python_engine.compile(property(CODE_PROPERTY_KEY)->value<QString>(), this);
 
-  if (m_points.size() > 0) {
-    auto locals = pybind11::dict( "points"_a=point_wrappers,
+  auto points = std::make_shared<std::vector<PointRecord>>(n, to_record(Point()));
+  if (n > 0) {
+    auto locals = pybind11::dict( "point_buffer"_a=make_point_buffer(points),
                                   "this"_a=ObjectWrapper::make(*this),
                                   "scene"_a=SceneWrapper(*scene()) );
-    scene()->python_engine.exec(code, locals, this);
+    if (references_name(code, "points")) {
+      // legacy interface: scripts which use `points` get one PointWrapper per point.
+      std::vector<Point> legacy_points(n);
+      std::vector<PointWrapper> point_wrappers;
+      point_wrappers.reserve(n);
+      for (Point& point : legacy_points) {
+        point_wrappers.emplace_back(point);
+      }
+      locals["points"] = point_wrappers;
+      python_engine.exec(code, locals, this);
+
+      // `points` may as well be an unrelated variable of a script which writes `point_buffer`.
+      // Only the points which were modified through the wrappers override the buffer.
+      for (std::size_t i = 0; i < n; ++i) {
+        if (legacy_points[i] != Point()) {
+          (*points)[i] = to_record(legacy_points[i]);
+        }
+      }
+    } else {
+      python_engine.exec(code, locals, this);
+    }
   }
+  m_points = std::move(points);
   Object::update();
 }
 
 Geom::PathVector ProceduralPath::paths() const
 {
   const bool is_closed = property(IS_CLOSED_PROPERTY_KEY)->value<bool>();
-  return segments_to_path_vector({ m_points }, is_closed);
+  const std::vector<PointRecord>& points = *m_points;
+  const std::size_t n = points.size();
+  if (n == 0) {
+    return Geom::PathVector();
+  }
+
+  // read the contiguous point buffer directly rather than converting it into `Point`s first.
+  const std::size_t m = is_closed ? n : n - 1;
+  std::vector<Geom::CubicBezier> bzs;
+  bzs.reserve(m);
+  for (std::size_t i = 0; i < m; ++i) {
+    const PointRecord& a = points[i];
+    const PointRecord& b = points[(i+1) % n];
+    bzs.emplace_back(cartesian(a.position), cartesian(a.position, a.right_tangent),
+                     cartesian(b.position, b.left_tangent), cartesian(b.position));
+  }
+  Geom::PathVector paths;
+  paths.push_back(Geom::Path(bzs.begin(), bzs.end(), is_closed));
+  return paths;
 }
 
 void ProceduralPath::on_property_value_changed(Property *property)
 {
-  if (   property == this->property(CODE_PROPERTY_KEY)
-      || property == this->property(COUNT_PROPERTY_KEY)
+  if (   property == this->property(COUNT_PROPERTY_KEY)
       || property == this->property(IS_CLOSED_PROPERTY_KEY))
   {
     update();
+  } else if (property == this->property(CODE_PROPERTY_KEY)) {
+    scene()->python_engine.invalidate_cache(this);
+    update();
   } else {
     Object::on_property_value_changed(property);
   }
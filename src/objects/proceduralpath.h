@@ -1,5 +1,6 @@
 #pragma once
 
+#include <memory>
 #include "objects/object.h"
 
 namespace omm
@@ -11,6 +12,8 @@ class ProceduralPath : public Object
 {
 public:
   explicit ProceduralPath(Scene* scene);
+  ProceduralPath(const ProceduralPath& other);
+  ~ProceduralPath();
   QString type() const override;
   static constexpr auto TYPE = QT_TRANSLATE_NOOP("any-context", "ProceduralPath");
   Flag flags() const override;
@@ -22,11 +25,26 @@ public:
   void update() override;
   Geom::PathVector paths() const override;
 
+  /**
+   * @brief The PointRecord struct is the memory layout of a point in the point buffer.
+   *  The buffer is exposed to python as structured numpy-array `point_buffer` without copying.
+   *  Tangents are stored in polar coordinates (argument, magnitude).
+   */
+  struct PointRecord
+  {
+    double position[2];
+    double left_tangent[2];
+    double right_tangent[2];
+    bool is_selected;
+  };
+
 protected:
   void on_property_value_changed(Property* property);
 
 private:
-  std::vector<Point> m_points;
+  // shared with the numpy arrays handed to the scripts, which may outlive an update.
+  std::shared_ptr<std::vector<PointRecord>> m_points
+      = std::make_shared<std::vector<PointRecord>>();
 
 };
 
@@ -5,6 +5,8 @@
 #include <QMessageBox>
 #include <qsettings.h>
 #include "mainwindow/mainwindow.h"
+#include "mainwindow/application.h"
+#include "animation/animator.h"
 #include "ui_generalpage.h"
 
 namespace
@@ -63,6 +65,11 @@ GeneralPage::GeneralPage(Preferences& preferences)
     const auto msg = tr("Changing language takes effect after restarting the application.");
     QMessageBox::information(this, MainWindow::tr("information"), msg);
   });
+
+  const QSettings settings;
+  m_ui->sb_frame_cache_budget->setValue(settings.value(FrameCache::BUDGET_SETTINGS_KEY, 0).toInt());
+  m_ui->cb_frame_cache_geometry->setChecked(
+        settings.value(FrameCache::CACHES_GEOMETRY_SETTINGS_KEY, true).toBool());
 }
 
 GeneralPage::~GeneralPage()
@@ -73,6 +80,14 @@ void GeneralPage::about_to_accept()
 {
   const QLocale locale(m_available_languages.at(m_ui->cb_language->currentIndex()));
   QSettings().setValue(MainWindow::LOCALE_SETTINGS_KEY, locale);
+
+  const int budget = m_ui->sb_frame_cache_budget->value();
+  const bool caches_geometry = m_ui->cb_frame_cache_geometry->isChecked();
+  QSettings().setValue(FrameCache::BUDGET_SETTINGS_KEY, budget);
+  QSettings().setValue(FrameCache::CACHES_GEOMETRY_SETTINGS_KEY, caches_geometry);
+  FrameCache& frame_cache = Application::instance().scene.animator().frame_cache();
+  frame_cache.set_budget(static_cast<std::size_t>(budget) * FrameCache::MEBIBYTE);
+  frame_cache.set_caches_geometry(caches_geometry);
 }
 
 }  // namespace omm
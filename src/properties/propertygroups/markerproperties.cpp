@@ -36,19 +36,29 @@ void MarkerProperties::make_properties(const QString &category) const
 
 void MarkerProperties
 ::draw_marker(Painter &painter, const Point &location, const Color& color, const double width) const
+{
+  draw_marker(painter, location, resolve(width), color);
+}
+
+MarkerProperties::Marker MarkerProperties::resolve(double width) const
+{
+  return { Painter::path(shape(width), true), property_value<bool>(REVERSE_PROPERTY_KEY) };
+}
+
+void MarkerProperties::draw_marker(Painter& painter, const Point& location, const Marker& marker,
+                                   const Color& color)
 {
   QPainter& p = *painter.painter;
   p.save();
   p.translate(to_qpoint(location.position));
-  if (property_value<bool>(REVERSE_PROPERTY_KEY)) {
+  if (marker.reverse) {
     p.rotate(location.rotation() * 180.0 * M_1_PI + 90);
   } else {
     p.rotate(location.rotation() * 180.0 * M_1_PI - 90);
   }
   p.setPen(Qt::NoPen);
   p.setBrush(color.to_qcolor());
-  QPainterPath path = Painter::path(shape(width), true);
-  p.drawPath(path);
+  p.drawPath(marker.path);
   p.restore();
 }
 
@@ -17,6 +17,21 @@ public:
   void draw_marker(Painter& painter, const Point& location,
                    const Color &color, const double width) const;
 
+  /**
+   * @brief The Marker struct holds the shape of a marker for a certain pen width, such that it
+   *  can be drawn without property lookups.
+   */
+  struct Marker
+  {
+    QPainterPath path;
+    bool reverse = false;
+    bool is_empty() const { return path.isEmpty(); }
+  };
+
+  Marker resolve(double width) const;
+  static void draw_marker(Painter& painter, const Point& location, const Marker& marker,
+                          const Color& color);
+
   static constexpr auto SHAPE_PROPERTY_KEY = "shape";
   static constexpr auto SIZE_PROPERTY_KEY = "size";
   static constexpr auto ASPECT_RATIO_PROPERTY_KEY = "aspectratio";
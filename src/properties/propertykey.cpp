@@ -0,0 +1,28 @@
+#include "properties/propertykey.h"
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+
+namespace omm
+{
+
+PropertyKey::PropertyKey(const QString& key) : m_string(key), m_id(intern(key))
+{
+}
+
+std::size_t PropertyKey::intern(const QString& key)
+{
+  static QMutex mutex;
+  static QHash<QString, std::size_t> ids;
+  QMutexLocker locker(&mutex);
+  const auto it = ids.constFind(key);
+  if (it == ids.constEnd()) {
+    const std::size_t id = static_cast<std::size_t>(ids.size());
+    ids.insert(key, id);
+    return id;
+  } else {
+    return it.value();
+  }
+}
+
+}  // namespace omm
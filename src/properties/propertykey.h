@@ -0,0 +1,46 @@
+#pragma once
+
+#include <atomic>
+#include <QString>
+
+namespace omm
+{
+
+/**
+ * @brief The PropertyKey class is an interned property key.
+ *  Interned keys are compared by id rather than by string.
+ *  A key remembers the slot, i.e., the position among the properties of an owner, at which it was
+ *  found last. Owners of the same class add their properties in the same order, hence the slot is
+ *  valid for all of them and `AbstractPropertyOwner::property(const PropertyKey&)` is mostly an
+ *  array access.
+ *  Keys are meant to be long-living (e.g., static) objects. A temporary key is not faster than
+ *  the plain string.
+ */
+class PropertyKey
+{
+public:
+  explicit PropertyKey(const QString& key);
+  PropertyKey(const PropertyKey&) = delete;
+  PropertyKey(PropertyKey&&) = delete;
+  PropertyKey& operator=(const PropertyKey&) = delete;
+  PropertyKey& operator=(PropertyKey&&) = delete;
+  ~PropertyKey() = default;
+
+  const QString& string() const { return m_string; }
+  std::size_t id() const { return m_id; }
+
+  /**
+   * @brief intern returns the id of @code key. Equal keys have equal ids. It is thread-safe.
+   */
+  static std::size_t intern(const QString& key);
+
+private:
+  const QString m_string;
+  const std::size_t m_id;
+
+  // the owners may be read from many threads, a stale slot is only a cache miss.
+  mutable std::atomic<std::size_t> m_slot { 0 };
+  friend class AbstractPropertyOwner;
+};
+
+}  // namespace omm
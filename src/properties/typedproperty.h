@@ -41,7 +41,7 @@ public:
 
 public:
   variant_type variant_value() const override { return m_value; }
-  ValueT value() const { return Property::value<ValueT>(); }
+  const ValueT& value() const { return m_value; }
   void set(const variant_type& variant) override { set(std::get<ValueT>(variant)); }
 
   virtual void set(const ValueT& value)
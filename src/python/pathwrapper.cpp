@@ -1,5 +1,6 @@
 #include "python/pathwrapper.h"
 #include "python/pointwrapper.h"
+#include <pybind11/numpy.h>
 
 namespace omm
 {
@@ -8,7 +9,9 @@ void PathWrapper::define_python_interface(py::object& module)
 {
   ObjectWrapper::register_wrapper<PathWrapper>();
   py::class_<PathWrapper, ObjectWrapper>(module, wrapped_type::TYPE)
-      .def("points", &PathWrapper::points);
+      .def("points", &PathWrapper::points)
+      .def("pos", &PathWrapper::pos)
+      .def("sample_by_distance", &PathWrapper::sample_by_distance);
 }
 
 py::object PathWrapper::points()
@@ -22,4 +25,26 @@ py::object PathWrapper::points()
   return py::cast(point_wrappers);
 }
 
+py::object PathWrapper::pos(double t)
+{
+  // compute_path_vector_time and pos read the cached geometry of the path.
+  auto& path = static_cast<wrapped_type&>(wrapped);
+  const auto point = path.pos(path.compute_path_vector_time(t));
+  return py::cast(point.position.to_stdvec());
+}
+
+py::object PathWrapper::sample_by_distance(const std::vector<double>& ts)
+{
+  auto& path = static_cast<wrapped_type&>(wrapped);
+  py::array_t<double> positions(std::vector<std::size_t>{ ts.size(), 2 });
+  double* data = positions.mutable_data();
+  for (std::size_t i = 0; i < ts.size(); ++i) {
+    const auto t = path.compute_path_vector_time(ts[i], Object::Interpolation::Distance);
+    const auto position = path.pos(t).position;
+    data[2*i] = position.x;
+    data[2*i + 1] = position.y;
+  }
+  return positions;
+}
+
 }  // namespace omm
@@ -13,6 +13,13 @@ public:
   using wrapped_type = Path;
   static void define_python_interface(py::object& module);
   py::object points();
+  py::object pos(double t);
+
+  /**
+   * @brief sample_by_distance returns the positions at the given normalized distances
+   *  as numpy-array of shape (len(ts), 2). The lookup uses the cached arc-length table.
+   */
+  py::object sample_by_distance(const std::vector<double>& ts);
 };
 
 }  // namespace omm
@@ -2,6 +2,7 @@
 #include <iostream>
 #include <pybind11/iostream.h>
 #include <functional>
+#include <map>
 #include "python/pythonengine.h"
 #include "scene/scene.h"
 #include "tags/scripttag.h"
@@ -61,7 +62,19 @@ namespace omm
 
 PYBIND11_EMBEDDED_MODULE(omm, m) { Q_UNUSED(m); }
 
-PythonEngine::PythonEngine()
+struct PythonEngine::CodeCache
+{
+  struct Entry
+  {
+    uint hash;
+    QString code;
+    py::object compiled;
+  };
+
+  std::map<const void*, Entry> entries;
+};
+
+PythonEngine::PythonEngine() : m_code_cache(std::make_unique<CodeCache>())
 {
   static size_t count = 0;
   if (count > 0) {
@@ -73,12 +86,29 @@ PythonEngine::PythonEngine()
   register_wrappers(omm_module);
 }
 
+PythonEngine::~PythonEngine() = default;
+
 bool PythonEngine
 ::exec(const QString& code, py::object& locals, const void* associated_item)
 {
+  return exec(compile(code, associated_item), locals, associated_item);
+}
+
+bool PythonEngine
+::exec(const py::object& compiled, py::object& locals, const void* associated_item)
+{
+  if (compiled.is_none()) {
+    return false;
+  }
+
   PythonStreamRedirect py_output_redirect {};
   try {
-    py::exec(code.toStdString(), py::globals(), locals);
+    py::object globals = py::globals();
+    PyObject* result = PyEval_EvalCode(compiled.ptr(), globals.ptr(), locals.ptr());
+    if (result == nullptr) {
+      throw py::error_already_set();
+    }
+    Py_DECREF(result);
     if (const auto stdout_ = py_output_redirect.stdout_(); !stdout_.isEmpty()) {
       Q_EMIT output(associated_item, stdout_, Stream::stdout_);
       LINFO << "Python output: " << stdout_;
@@ -95,6 +125,34 @@ bool PythonEngine
   }
 }
 
+py::object PythonEngine::compile(const QString& code, const void* associated_item)
+{
+  const uint hash = qHash(code);
+  auto& entries = m_code_cache->entries;
+  if (const auto it = entries.find(associated_item);
+      it != entries.end() && it->second.hash == hash && it->second.code == code)
+  {
+    m_cache_statistics.hits += 1;
+    return it->second.compiled;
+  }
+
+  m_cache_statistics.misses += 1;
+  py::object compiled = py::none();
+  try {
+    compiled = py::module::import("builtins").attr("compile")(code.toStdString(), "<string>", "exec");
+  } catch (const std::exception& e) {
+    LERROR << "Python exception: " << e.what();
+    Q_EMIT output(associated_item, e.what(), Stream::stderr_);
+  }
+  entries[associated_item] = CodeCache::Entry{ hash, code, compiled };
+  return compiled;
+}
+
+void PythonEngine::invalidate_cache(const void* associated_item)
+{
+  m_code_cache->entries.erase(associated_item);
+}
+
 pybind11::object PythonEngine
 ::eval(const QString& code, py::object& locals, const void* associated_item)
 {
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <memory>
 #include <pybind11/embed.h>
 #include "python/scopedinterpreterwrapper.h"
 #include <QObject>
@@ -17,17 +18,48 @@ class PythonEngine : public QObject
   Q_OBJECT
 public:
   explicit PythonEngine();
+  ~PythonEngine() override;
   bool
   exec(const QString& code, pybind11::object& locals, const void* association);
+  bool
+  exec(const pybind11::object& compiled, pybind11::object& locals, const void* association);
   pybind11::object
   eval(const QString& code, pybind11::object& locals, const void* association);
 
+  /**
+   * @brief compile returns the compiled code object of @code code.
+   *  The code object is cached per @code association and is only recompiled if the hash of the
+   *  source differs from the cached one.
+   *  If the code cannot be compiled, `None` is returned (and cached).
+   */
+  pybind11::object compile(const QString& code, const void* association);
+
+  /**
+   * @brief invalidate_cache removes the cached code object of @code association.
+   *  Call this function if the code changes or the associated item is deleted.
+   */
+  void invalidate_cache(const void* association);
+
+  struct CacheStatistics
+  {
+    std::size_t hits = 0;
+    std::size_t misses = 0;
+  };
+  CacheStatistics cache_statistics() const { return m_cache_statistics; }
+
 private:
   // the scoped_interpeter has same lifetime as the application.
   // otherwise, e.g., importing numpy causes crashed.
   // see https://pybind11.readthedocs.io/en/stable/advanced/embedding.html#interpreter-lifetime
   ScopedInterpreterWrapper m_guard;
 
+  // pybind11-types shall not be mentioned in the header, see ScopedInterpreterWrapper.
+  // The cache must be declared after m_guard, the code objects must be released while the
+  // interpreter is alive.
+  struct CodeCache;
+  std::unique_ptr<CodeCache> m_code_cache;
+  CacheStatistics m_cache_statistics;
+
   PythonEngine(const PythonEngine&) = delete;
   PythonEngine(PythonEngine&&) = delete;
 
@@ -58,7 +58,7 @@ void Painter::render(Options options)
 void Painter::push_transformation(const ObjectTransformation &transformation)
 {
   m_transformation_stack.push(current_transformation().apply(transformation));
-  painter->setTransform(to_transformation(current_transformation()), false);
+  painter->setTransform(to_transformation(m_transformation_stack.top()), false);
 }
 
 void Painter::pop_transformation()
@@ -67,6 +67,12 @@ void Painter::pop_transformation()
   painter->setTransform(to_transformation(current_transformation()), false);
 }
 
+void Painter::set_painter(QPainter& painter)
+{
+  this->painter = &painter;
+  painter.setTransform(to_transformation(current_transformation()), false);
+}
+
 ObjectTransformation Painter::current_transformation() const
 {
   if (m_transformation_stack.size() == 0) {
@@ -124,8 +130,8 @@ QPainterPath Painter::path(const std::vector<Point> &points, bool closed)
 
 QBrush Painter::make_brush(const Style &style, const Object& object, const Painter::Options& options)
 {
-  if (style.property(omm::Style::BRUSH_IS_ACTIVE_KEY)->value<bool>()) {
-    if (style.property("gl-brush")->value<bool>()) {
+  if (const Style::Resolved& resolved = style.resolved(); resolved.brush_is_active) {
+    if (resolved.is_view_dependent) {
       const auto l_bb = object.bounding_box(ObjectTransformation());
       const auto v_bb = object.bounding_box(object.global_transformation(Space::Viewport));
       const double fx = std::abs(v_bb.width() / l_bb.width());
@@ -134,8 +140,8 @@ QBrush Painter::make_brush(const Style &style, const Object& object, const Paint
       QSize size = (f * QSizeF(l_bb.width(), l_bb.height())).toSize();
       const QRectF roi = get_roi(object.global_transformation(Space::Viewport), l_bb, options);
       Texture texture = style.render_texture(object, size, roi, options);
-      QPixmap pixmap = QPixmap::fromImage(texture.image);
-      QBrush brush(pixmap);
+      // an image brush, unlike a pixmap brush, can be replayed outside the GUI thread.
+      QBrush brush(texture.image);
       QTransform t;
       t.scale(1.0/f, 1.0/f);
       t.translate(-size.width() / 2.0 + texture.offset.x(),
@@ -143,7 +149,7 @@ QBrush Painter::make_brush(const Style &style, const Object& object, const Paint
       brush.setTransform(t);
       return brush;
     } else {
-      return make_simple_brush(style);
+      return resolved.simple_brush;
     }
   } else {
     return QBrush(Qt::NoBrush);
@@ -165,7 +171,7 @@ QBrush Painter::make_simple_brush(const Style &style)
 QPen Painter::make_pen(const Style &style, const Object& object)
 {
   Q_UNUSED(object);
-  return make_simple_pen(style);
+  return style.resolved().pen;
 }
 
 QPen Painter::make_simple_pen(const Style &style)
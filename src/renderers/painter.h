@@ -2,6 +2,8 @@
 
 #include <string>
 #include <stack>
+#include <optional>
+#include <functional>
 
 #include "geometry/objecttransformation.h"
 #include "geometry/boundingbox.h"
@@ -33,6 +35,12 @@ public:
     explicit Options(const QPaintDevice& device);
     std::vector<const Style*> styles;
     const Style* default_style = nullptr;
+
+    /**
+     * @brief culling_bounds objects whose scene bounding box does not intersect these bounds
+     *  (in scene coordinates) are not drawn. Nothing is culled if unset.
+     */
+    std::optional<BoundingBox> culling_bounds;
     const bool device_is_viewport;
     const QPaintDevice& device;
   };
@@ -46,6 +54,11 @@ public:
   void pop_transformation();
   ObjectTransformation current_transformation() const;
 
+  /**
+   * @brief set_painter exchanges `painter`. The current transformation is carried over.
+   */
+  void set_painter(QPainter& painter);
+
   void toast(const Vec2f& pos, const QString& text);
 
   static QPainterPath path(const std::vector<Point>& points, bool closed = false);
@@ -60,6 +73,12 @@ public:
   Scene& scene;
   Category category_filter;
   QPainter* painter = nullptr;
+
+  /**
+   * @brief begin_object is called, if set, before each object draws itself.
+   *  It allows to record the objects separately (see `set_painter`).
+   */
+  std::function<void()> begin_object;
   ImageCache image_cache;
 
 private:
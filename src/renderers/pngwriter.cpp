@@ -0,0 +1,93 @@
+#include "renderers/pngwriter.h"
+#include <QFile>
+#include "logging.h"
+
+namespace omm
+{
+
+// libpng reports errors with longjmp. Hence, no object with a non-trivial destructor must be
+// constructed between `setjmp` and the calls to libpng.
+
+PngWriter::PngWriter(const QString& filename, const QSize& size)
+  : m_filename(filename), m_size(size)
+{
+  m_file = std::fopen(QFile::encodeName(filename).constData(), "wb");
+  if (m_file == nullptr) {
+    LERROR << "Failed to open '" << filename << "'.";
+    m_failed = true;
+    m_finished = true;  // there is no file to remove.
+    return;
+  }
+
+  m_png = png_create_write_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
+  if (m_png != nullptr) {
+    m_info = png_create_info_struct(m_png);
+  }
+  if (m_info == nullptr) {
+    m_failed = true;
+    return;
+  }
+
+  if (setjmp(png_jmpbuf(m_png))) {
+    m_failed = true;
+    return;
+  }
+  png_init_io(m_png, m_file);
+  png_set_IHDR(m_png, m_info,
+               static_cast<png_uint_32>(size.width()), static_cast<png_uint_32>(size.height()),
+               8, PNG_COLOR_TYPE_RGB_ALPHA, PNG_INTERLACE_NONE,
+               PNG_COMPRESSION_TYPE_DEFAULT, PNG_FILTER_TYPE_DEFAULT);
+  png_write_info(m_png, m_info);
+}
+
+PngWriter::~PngWriter()
+{
+  png_destroy_write_struct(&m_png, &m_info);
+  if (m_file != nullptr) {
+    std::fclose(m_file);
+  }
+  if (!m_finished) {
+    LWARNING << "Removing incomplete '" << m_filename << "'.";
+    QFile::remove(m_filename);
+  }
+}
+
+bool PngWriter::write(const QImage& band)
+{
+  if (m_failed || band.width() != m_size.width() || m_n_rows + band.height() > m_size.height()) {
+    m_failed = true;
+    return false;
+  }
+
+  // PNG expects straight, i.e., non-premultiplied, alpha.
+  const QImage rgba = band.convertToFormat(QImage::Format_RGBA8888);
+  if (setjmp(png_jmpbuf(m_png))) {
+    m_failed = true;
+    return false;
+  }
+  for (int y = 0; y < rgba.height(); ++y) {
+    png_write_row(m_png, rgba.constScanLine(y));
+  }
+  m_n_rows += rgba.height();
+  return true;
+}
+
+bool PngWriter::finish()
+{
+  if (m_failed || m_finished || m_n_rows != m_size.height()) {
+    m_failed = true;
+    return false;
+  }
+
+  if (setjmp(png_jmpbuf(m_png))) {
+    m_failed = true;
+    return false;
+  }
+  png_write_end(m_png, nullptr);
+  m_finished = std::fclose(m_file) == 0;
+  m_file = nullptr;
+  m_failed = !m_finished;
+  return m_finished;
+}
+
+}  // namespace omm
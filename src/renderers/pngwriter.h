@@ -0,0 +1,55 @@
+#pragma once
+
+#include <QImage>
+#include <QSize>
+#include <cstdio>
+#include <png.h>
+
+namespace omm
+{
+
+/**
+ * @brief The PngWriter class writes a PNG file row by row.
+ *  Unlike `QImage::save`, it does not require the whole image in memory. The image is passed in
+ *  horizontal bands, from top to bottom, which are encoded and written immediately.
+ */
+class PngWriter
+{
+public:
+  explicit PngWriter(const QString& filename, const QSize& size);
+
+  /**
+   * @brief ~PngWriter removes the file unless `finish` succeeded, an incomplete image is never
+   *  left behind.
+   */
+  ~PngWriter();
+  PngWriter(const PngWriter&) = delete;
+  PngWriter(PngWriter&&) = delete;
+  PngWriter& operator=(const PngWriter&) = delete;
+  PngWriter& operator=(PngWriter&&) = delete;
+
+  /**
+   * @brief write appends the rows of @code band to the image.
+   *  The width of @code band must be the width of the image.
+   * @return false if writing failed. All further calls will fail then, too.
+   */
+  bool write(const QImage& band);
+
+  /**
+   * @brief finish completes and closes the file.
+   * @return true if all rows have been written successfully.
+   */
+  bool finish();
+
+private:
+  const QString m_filename;
+  const QSize m_size;
+  std::FILE* m_file = nullptr;
+  png_structp m_png = nullptr;
+  png_infop m_info = nullptr;
+  int m_n_rows = 0;
+  bool m_failed = false;
+  bool m_finished = false;
+};
+
+}  // namespace omm
@@ -28,6 +28,12 @@ static constexpr auto end_marker_prefix = "end";
 static constexpr double default_marker_size = 2.0;
 static constexpr auto default_marker_shape = omm::MarkerProperties::Shape::None;
 
+std::size_t next_version()
+{
+  static std::size_t version = 0;
+  return ++version;
+}
+
 }  // namespace
 
 namespace omm
@@ -38,7 +44,9 @@ Style::Style(Scene *scene)
   , NodesOwner(AbstractNodeCompiler::Language::GLSL, *scene)
   , start_marker(start_marker_prefix, *this, default_marker_shape, default_marker_size)
   , end_marker(end_marker_prefix, *this, default_marker_shape, default_marker_size)
+  , resolved(*this)
   , m_offscreen_renderer(OffscreenRenderer::make())
+  , m_version(next_version())
 {
   const auto pen_category = QObject::tr("pen");
   const auto brush_category = QObject::tr("brush");
@@ -103,7 +111,9 @@ Style::Style(const Style &other)
   : PropertyOwner(other), NodesOwner(other)
   , start_marker(start_marker_prefix, *this, default_marker_shape, default_marker_size)
   , end_marker(end_marker_prefix, *this, default_marker_shape, default_marker_size)
+  , resolved(*this)
   , m_offscreen_renderer(std::make_unique<OffscreenRenderer>())
+  , m_version(next_version())
 {
   other.copy_properties(*this, CopiedProperties::Compatible);
   polish();
@@ -152,10 +162,14 @@ void Style::deserialize(AbstractDeserializer& deserializer, const Serializable::
   if (NodeModel* node_model = this->node_model(); node_model != nullptr) {
     node_model->deserialize(deserializer, make_pointer(root, NODES_POINTER));
   }
+  m_version = next_version();
+  resolved.invalidate();
 }
 
 void Style::on_property_value_changed(Property *property)
 {
+  m_version = next_version();
+  resolved.invalidate();
   if (    property == this->property(PEN_IS_ACTIVE_KEY)
        || property == this->property(PEN_COLOR_KEY)
        || property == this->property(PEN_WIDTH_KEY)
@@ -172,6 +186,22 @@ void Style::on_property_value_changed(Property *property)
   }
 }
 
+Style::Resolved Style::CachedResolvedGetter::compute() const
+{
+  const Style& style = m_self;
+  Resolved resolved;
+  resolved.pen = Painter::make_simple_pen(style);
+  resolved.simple_brush = Painter::make_simple_brush(style);
+  resolved.brush_is_active = style.property(BRUSH_IS_ACTIVE_KEY)->value<bool>();
+  resolved.is_view_dependent = resolved.brush_is_active
+                               && style.property("gl-brush")->value<bool>();
+  resolved.pen_color = style.property(PEN_COLOR_KEY)->value<Color>();
+  resolved.pen_width = style.property(PEN_WIDTH_KEY)->value<double>();
+  resolved.start_marker = style.start_marker.resolve(resolved.pen_width);
+  resolved.end_marker = style.end_marker.resolve(resolved.pen_width);
+  return resolved;
+}
+
 void Style::update_uniform_values() const
 {
   if (const NodeModel* node_model = this->node_model(); node_model != nullptr) {
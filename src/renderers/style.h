@@ -8,6 +8,7 @@
 #include "nodesystem/nodesowner.h"
 #include "nodesystem/nodecompilerglsl.h"
 #include "renderers/texture.h"
+#include "cachedgetter.h"
 
 namespace omm
 {
@@ -55,8 +56,47 @@ public:
   const MarkerProperties end_marker;
   void on_property_value_changed(Property* property) override;
 
+  /**
+   * @brief version changes whenever any property of this style changes.
+   *  Versions are unique among all styles, hence a version identifies a style and its state.
+   */
+  std::size_t version() const { return m_version; }
+
+  /**
+   * @brief is_view_dependent returns true if the drawing depends on the view transformation, i.e.,
+   *  if the brush is rendered with OpenGL.
+   */
+  bool is_view_dependent() const { return resolved().is_view_dependent; }
+
+  /**
+   * @brief The Resolved struct holds everything which is required to draw with this style.
+   *  Drawing reads it rather than looking up the properties each time.
+   */
+  struct Resolved
+  {
+    QPen pen;
+    QBrush simple_brush;
+    bool brush_is_active;
+    bool is_view_dependent;
+    Color pen_color;
+    double pen_width;
+    MarkerProperties::Marker start_marker;
+    MarkerProperties::Marker end_marker;
+  };
+
+  /**
+   * @brief resolved caches the `Resolved` style. It is invalidated whenever a property changes.
+   */
+  struct CachedResolvedGetter : CachedGetter<Resolved, Style>
+  {
+    using CachedGetter::CachedGetter;
+  private:
+    Resolved compute() const override;
+  } resolved;
+
 private:
   std::unique_ptr<OffscreenRenderer> m_offscreen_renderer;
+  std::size_t m_version;
   void update_uniform_values() const;
   std::set<Property*> m_uniform_values;
   void polish();
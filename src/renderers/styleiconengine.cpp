@@ -23,8 +23,8 @@ double adjust_pen_width(double width, const QSize& size)
 void draw_style(QPainter& painter, const QRect& rect, const omm::Style& style)
 {
   painter.save();
-  painter.setBrush(omm::Painter::make_simple_brush(style));
-  auto pen = omm::Painter::make_simple_pen(style);
+  painter.setBrush(style.resolved().simple_brush);
+  auto pen = style.resolved().pen;
   pen.setWidthF(adjust_pen_width(pen.width(), rect.size()));
   painter.setPen(pen);
   const auto r = 0.8 * std::min(rect.size().width(), rect.size().height());
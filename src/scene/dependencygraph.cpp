@@ -0,0 +1,208 @@
+#include "scene/dependencygraph.h"
+#include <algorithm>
+#include "common.h"
+#include "objects/object.h"
+#include "properties/referenceproperty.h"
+#include "scene/messagebox.h"
+#include "scene/scene.h"
+
+namespace omm
+{
+
+DependencyGraph::DependencyGraph(Scene& scene) : m_scene(scene)
+{
+  MessageBox& message_box = m_scene.message_box();
+  connect(&message_box, qOverload<Object&>(&MessageBox::appearance_changed),
+          this, [this](Object& object)
+  {
+    on_change(object, Change::Appearance);
+  });
+  connect(&message_box, &MessageBox::transformation_changed, this, [this](Object& object) {
+    on_change(object, Change::Transformation);
+  });
+  connect(&message_box, &MessageBox::property_value_changed, this,
+          [this](AbstractPropertyOwner&, const QString&, Property& property)
+  {
+    if (type_cast<ReferenceProperty*>(&property) != nullptr) {
+      invalidate_referrers();
+    }
+  });
+}
+
+void DependencyGraph::add_children_dependency(Object& dependent)
+{
+  m_children_dependents.insert(&dependent);
+}
+
+void DependencyGraph::add_reference_dependency(Object& dependent,
+                                               const std::function<Object*()>& get_reference)
+{
+  m_reference_dependents[&dependent].push_back(get_reference);
+  invalidate_referrers();
+}
+
+void DependencyGraph::remove(Object& object)
+{
+  m_children_dependents.erase(&object);
+  m_reference_dependents.erase(&object);
+  invalidate_referrers();
+  if (m_scheduled.erase(&object) > 0) {
+    m_pending.erase(m_pending.find({ m_ranks.at(&object), &object }));
+  }
+  m_evaluated.erase(&object);
+  m_ranks.erase(&object);
+  m_subtree_ranks.erase(&object);
+}
+
+std::unique_ptr<DependencyGraph::Batch> DependencyGraph::make_batch(bool defer_updates)
+{
+  return std::make_unique<Batch>(*this, defer_updates);
+}
+
+bool DependencyGraph::defer_update(Object& object)
+{
+  if (m_n_deferring_batches == 0 || ::contains(m_evaluated, &object)) {
+    return false;
+  } else {
+    if (m_scheduled.insert(&object).second) {
+      m_pending.insert({ rank(object), &object });
+    }
+    return true;
+  }
+}
+
+const std::map<const Object*, std::set<Object*>>& DependencyGraph::referrers() const
+{
+  if (!m_referrers) {
+    m_referrers.emplace();
+    for (auto&& [dependent, get_references] : m_reference_dependents) {
+      for (auto&& get_reference : get_references) {
+        if (const Object* reference = get_reference(); reference != nullptr) {
+          (*m_referrers)[reference].insert(dependent);
+        }
+      }
+    }
+  }
+  return *m_referrers;
+}
+
+void DependencyGraph::invalidate_referrers()
+{
+  m_referrers.reset();
+}
+
+void DependencyGraph::on_change(Object& object, Change change)
+{
+  const auto batch = make_batch();
+
+  // the objects which depend on their children and have `object` as descendant.
+  for (Object* ancestor = &object; !ancestor->is_root();) {
+    ancestor = &ancestor->tree_parent();
+    if (::contains(m_children_dependents, ancestor)) {
+      schedule(*ancestor, object, change);
+    }
+  }
+
+  // the objects which reference `object` or one of its ancestors.
+  const auto& referrers = this->referrers();
+  for (Object* ancestor = &object; ancestor != nullptr;) {
+    if (const auto it = referrers.find(ancestor); it != referrers.end()) {
+      for (Object* dependent : it->second) {
+        schedule(*dependent, object, change);
+      }
+    }
+    ancestor = ancestor->is_root() ? nullptr : &ancestor->tree_parent();
+  }
+}
+
+void DependencyGraph::schedule(Object& dependent, Object& dependency, Change change)
+{
+  if (::contains(m_evaluated, &dependent)) {
+    // the dependency graph is cyclic (e.g., an instance of an ancestor).
+    // `dependent` has been updated in this batch already.
+    return;
+  }
+  dependent.on_dependency_changed(dependency, change);
+  if (m_scheduled.insert(&dependent).second) {
+    m_pending.insert({ rank(dependent), &dependent });
+  }
+}
+
+void DependencyGraph::flush()
+{
+  // the updates cause more changes. They must join this batch rather than opening a new one.
+  m_batch_depth += 1;
+  while (!m_pending.empty()) {
+    Object& dependent = *m_pending.begin()->second;
+    m_pending.erase(m_pending.begin());
+    m_scheduled.erase(&dependent);
+    m_evaluated.insert(&dependent);
+    dependent.update();
+  }
+  m_batch_depth -= 1;
+  m_evaluated.clear();
+  m_ranks.clear();
+  m_subtree_ranks.clear();
+}
+
+std::size_t DependencyGraph::rank(Object& object)
+{
+  if (const auto it = m_ranks.find(&object); it != m_ranks.end()) {
+    return it->second;
+  }
+
+  // the provisional rank breaks cycles.
+  m_ranks.insert({ &object, 0 });
+  std::size_t rank = 0;
+  if (::contains(m_children_dependents, &object)) {
+    for (Object* child : object.tree_children()) {
+      rank = std::max(rank, subtree_rank(*child) + 1);
+    }
+  }
+  if (const auto it = m_reference_dependents.find(&object); it != m_reference_dependents.end()) {
+    for (auto&& get_reference : it->second) {
+      if (Object* reference = get_reference(); reference != nullptr) {
+        rank = std::max(rank, subtree_rank(*reference) + 1);
+      }
+    }
+  }
+  m_ranks[&object] = rank;
+  return rank;
+}
+
+std::size_t DependencyGraph::subtree_rank(Object& object)
+{
+  if (const auto it = m_subtree_ranks.find(&object); it != m_subtree_ranks.end()) {
+    return it->second;
+  }
+
+  m_subtree_ranks.insert({ &object, 0 });
+  std::size_t rank = this->rank(object);
+  for (Object* child : object.tree_children()) {
+    rank = std::max(rank, subtree_rank(*child));
+  }
+  m_subtree_ranks[&object] = rank;
+  return rank;
+}
+
+DependencyGraph::Batch::Batch(DependencyGraph& graph, bool defer_updates)
+  : m_graph(graph), m_defers_updates(defer_updates)
+{
+  m_graph.m_batch_depth += 1;
+  if (m_defers_updates) {
+    m_graph.m_n_deferring_batches += 1;
+  }
+}
+
+DependencyGraph::Batch::~Batch()
+{
+  if (m_defers_updates) {
+    m_graph.m_n_deferring_batches -= 1;
+  }
+  m_graph.m_batch_depth -= 1;
+  if (m_graph.m_batch_depth == 0) {
+    m_graph.flush();
+  }
+}
+
+}  // namespace omm
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <QObject>
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <set>
+#include <vector>
+
+namespace omm
+{
+
+class Object;
+class Scene;
+
+/**
+ * @brief The DependencyGraph class updates the objects whose geometry depends on other objects.
+ *  An object may depend on its descendants (see `add_children_dependency`) and on the objects
+ *  referenced by its properties, including their descendants (see `add_reference_dependency`).
+ *  When an object changes, the dependents are looked up along its ancestors rather than asking
+ *  each dependent whether it is affected.
+ *  The dependents are updated in topological order, i.e., after all their dependencies, and each
+ *  dependent is updated at most once per batch.
+ *  A batch spans the handling of a single `MessageBox::appearance_changed(Object&)` or
+ *  `MessageBox::transformation_changed` emission unless it is extended by `make_batch`.
+ *  A batch can defer `Object::update`, too. The objects which request an update are then updated
+ *  once, together with their dependents, when the batch ends.
+ */
+class DependencyGraph : public QObject
+{
+  Q_OBJECT
+public:
+  explicit DependencyGraph(Scene& scene);
+
+  enum class Change { Appearance, Transformation };
+
+  /**
+   * @brief add_children_dependency makes @code dependent depend on all its descendants.
+   */
+  void add_children_dependency(Object& dependent);
+
+  /**
+   * @brief add_reference_dependency makes @code dependent depend on the object returned by
+   *  @code get_reference and on its descendants. @code get_reference may return nullptr.
+   *  The reference is resolved again whenever any `ReferenceProperty` changes.
+   */
+  void add_reference_dependency(Object& dependent, const std::function<Object*()>& get_reference);
+
+  /**
+   * @brief remove forgets everything about @code object. It must be called before @code object
+   *  is destroyed.
+   */
+  void remove(Object& object);
+
+  class Batch
+  {
+  public:
+    explicit Batch(DependencyGraph& graph, bool defer_updates);
+    ~Batch();
+    Batch(const Batch&) = delete;
+    Batch(Batch&&) = delete;
+    Batch& operator=(const Batch&) = delete;
+    Batch& operator=(Batch&&) = delete;
+
+  private:
+    DependencyGraph& m_graph;
+    const bool m_defers_updates;
+  };
+
+  /**
+   * @brief make_batch defers the update of the dependents until the returned batch and all other
+   *  batches are destroyed. Use it to update the dependents only once if many objects or
+   *  properties are changed in a row.
+   * @param defer_updates if true, calls of `Object::update` are deferred, too, while the returned
+   *  batch is alive. Objects must not be queried for their geometry in that time.
+   */
+  [[nodiscard]] std::unique_ptr<Batch> make_batch(bool defer_updates = false);
+
+  /**
+   * @brief defer_update schedules the update of @code object if a batch defers updates.
+   * @return true if the update was deferred, false if @code object must be updated immediately.
+   */
+  bool defer_update(Object& object);
+
+private:
+  Scene& m_scene;
+  std::set<const Object*> m_children_dependents;
+  std::map<Object*, std::vector<std::function<Object*()>>> m_reference_dependents;
+
+  // maps the referenced objects to the objects which depend on them. It is built lazily.
+  mutable std::optional<std::map<const Object*, std::set<Object*>>> m_referrers;
+  const std::map<const Object*, std::set<Object*>>& referrers() const;
+  void invalidate_referrers();
+
+  void on_change(Object& object, Change change);
+  void schedule(Object& dependent, Object& dependency, Change change);
+  void flush();
+
+  // the ranks are only valid during a batch since the tree and the references may change.
+  std::map<const Object*, std::size_t> m_ranks;
+  std::map<const Object*, std::size_t> m_subtree_ranks;
+  std::size_t rank(Object& object);
+  std::size_t subtree_rank(Object& object);
+
+  std::size_t m_batch_depth = 0;
+  std::size_t m_n_deferring_batches = 0;
+  std::set<std::pair<std::size_t, Object*>> m_pending;
+  std::set<const Object*> m_scheduled;
+  std::set<const Object*> m_evaluated;
+};
+
+}  // namespace omm
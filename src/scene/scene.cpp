@@ -4,6 +4,7 @@
 #include <QDebug>
 #include <variant>
 #include <QTimer>
+#include <QFileInfo>
 #include <QMessageBox>
 #include <fstream>
 #include <QApplication>
@@ -14,6 +15,7 @@
 #include "properties/stringproperty.h"
 #include "properties/boolproperty.h"
 #include "serializers/jsonserializer.h"
+#include "serializers/binaryserializer.h"
 #include "commands/command.h"
 #include "properties/referenceproperty.h"
 #include "properties/colorproperty.h"
@@ -33,6 +35,8 @@
 #include "scene/messagebox.h"
 #include "animation/animator.h"
 #include "color/namedcolors.h"
+#include "scene/spatialindex.h"
+#include "scene/dependencygraph.h"
 #include "nodesystem/node.h"
 
 namespace
@@ -88,6 +92,15 @@ template<typename T> std::set<T*> filter_by_name(const std::set<T*>& set, const
   return ::filter_if(set, [name](const T* t) { return t->name() == name; });
 }
 
+std::unique_ptr<omm::AbstractDeserializer> make_deserializer(std::istream& istream, bool is_binary)
+{
+  if (is_binary) {
+    return std::make_unique<omm::BinaryDeserializer>(istream);
+  } else {
+    return std::make_unique<omm::JSONDeserializer>(istream);
+  }
+}
+
 }  // namespace
 
 namespace omm
@@ -97,12 +110,14 @@ Scene::Scene(PythonEngine& python_engine)
   : python_engine(python_engine)
   , point_selection(*this)
   , m_message_box(new MessageBox())
+  , m_dependency_graph(new DependencyGraph(*this))
   , m_object_tree(new ObjectTree(make_root(), *this))
   , m_styles(new StyleList(*this))
   , m_history(new HistoryModel())
   , m_tool_box(new ToolBox(*this))
   , m_animator(new Animator(*this))
   , m_named_colors(new NamedColors())
+  , m_spatial_index(new SpatialIndex(*this))
 {
   object_tree().root().set_object_tree(object_tree());
   for (auto kind : { Object::KIND, Tag::KIND, Style::KIND, Tool::KIND }) {
@@ -111,6 +126,17 @@ Scene::Scene(PythonEngine& python_engine)
   connect(&history(), SIGNAL(index_changed()), &message_box(), SIGNAL(filename_changed()));
   connect(&message_box(), SIGNAL(selection_changed(std::set<AbstractPropertyOwner*>)),
           this, SLOT(update_tool()));
+  connect(&message_box(), qOverload<Object&>(&MessageBox::appearance_changed), this,
+          [](Object& object)
+  {
+    object.invalidate_scene_bounding_box(false);
+  });
+  connect(&message_box(), &MessageBox::transformation_changed, this, [](Object& object) {
+    // the root's transformation is the viewport transformation, it does not affect scene space.
+    if (!object.is_root()) {
+      object.invalidate_scene_bounding_box(true);
+    }
+  });
 }
 
 Scene::~Scene()
@@ -181,23 +207,39 @@ std::set<ColorProperty*> Scene::find_named_color_holders(const QString& name) co
 
 bool Scene::save_as(const QString &filename)
 {
-  std::ofstream ofstream(filename.toStdString());
+  const bool is_binary = is_binary_file(filename);
+  std::ofstream ofstream(filename.toStdString(), is_binary ? std::ios::binary : std::ios::out);
   if (!ofstream) {
     LERROR <<  "Failed to open ofstream at '" << filename << "'.";
     return false;
   }
 
-  JSONSerializer serializer(static_cast<std::ostream&>(ofstream));
-  object_tree().root().serialize(serializer, ROOT_POINTER);
+  {
+    // the serializer must be destroyed before the file is closed.
+    std::unique_ptr<AbstractSerializer> serializer;
+    if (is_binary) {
+      serializer = std::make_unique<BinarySerializer>(ofstream);
+    } else {
+      serializer = std::make_unique<JSONSerializer>(ofstream);
+    }
+    object_tree().root().serialize(*serializer, ROOT_POINTER);
+
+    serializer->start_array(styles().items().size(), Serializable::make_pointer(STYLES_POINTER));
+    for (size_t i = 0; i < styles().items().size(); ++i) {
+      styles().item(i).serialize(*serializer, Serializable::make_pointer(STYLES_POINTER, i));
+    }
+    serializer->end_array();
 
-  serializer.start_array(styles().items().size(), Serializable::make_pointer(STYLES_POINTER));
-  for (size_t i = 0; i < styles().items().size(); ++i) {
-    styles().item(i).serialize(serializer, Serializable::make_pointer(STYLES_POINTER, i));
+    animator().serialize(*serializer, ANIMATOR_POINTER);
+    named_colors().serialize(*serializer, NAMED_COLORS_POINTER);
   }
-  serializer.end_array();
 
-  animator().serialize(serializer, ANIMATOR_POINTER);
-  named_colors().serialize(serializer, NAMED_COLORS_POINTER);
+  // the serializers write the end of the file when they are destroyed.
+  ofstream.close();
+  if (!ofstream) {
+    LERROR << "Failed to write '" << filename << "'.";
+    return false;
+  }
 
   LINFO << "Saved current scene to '" << filename << "'.";
   history().set_saved_index();
@@ -206,11 +248,12 @@ bool Scene::save_as(const QString &filename)
   return true;
 }
 
-bool Scene::load_from(const QString &filename)
+bool Scene::load_from(const QString &filename, const SceneIndex::Predicate& filter)
 {
   reset();
 
-  std::ifstream ifstream(filename.toStdString());
+  const bool is_binary = is_binary_file(filename);
+  std::ifstream ifstream(filename.toStdString(), is_binary ? std::ios::binary : std::ios::in);
   if (!ifstream) {
     LERROR << "Failed to open '" << filename << "'.";
     return false;
@@ -223,10 +266,26 @@ bool Scene::load_from(const QString &filename)
   };
 
   try {
-    JSONDeserializer deserializer(static_cast<std::istream&>(ifstream));
+    const auto deserializer_ptr = make_deserializer(ifstream, is_binary);
+    AbstractDeserializer& deserializer = *deserializer_ptr;
+    if (filter) {
+      deserializer.restrict_objects(SceneIndex(deserializer, ROOT_POINTER).closure(filter));
+    }
+
+    {
+      // the top-level subtrees are independent, they can be decoded in parallel.
+      // The objects are instantiated and adopted on this thread, references are set in `polish`.
+      const auto children_pointer = Serializable::make_pointer(ROOT_POINTER,
+                                                               Object::CHILDREN_POINTER);
+      deserializer.decode(deserializer.accepted_objects(children_pointer));
+    }
 
     auto new_root = make_root();
-    new_root->deserialize(deserializer, ROOT_POINTER);
+    {
+      // each adopted child notifies its dependents. Update them once, not once per child.
+      const auto batch = dependency_graph().make_batch();
+      new_root->deserialize(deserializer, ROOT_POINTER);
+    }
 
     const auto n_styles = deserializer.array_size(Serializable::make_pointer(STYLES_POINTER));
     std::vector<std::unique_ptr<Style>> styles;
@@ -262,6 +321,37 @@ bool Scene::load_from(const QString &filename)
   return false;
 }
 
+std::optional<SceneIndex> Scene::index(const QString& filename)
+{
+  const bool is_binary = is_binary_file(filename);
+  std::ifstream ifstream(filename.toStdString(), is_binary ? std::ios::binary : std::ios::in);
+  if (!ifstream) {
+    LERROR << "Failed to open '" << filename << "'.";
+    return std::nullopt;
+  }
+
+  auto error_handler = [filename](const QString& msg) {
+    LERROR << "Failed to index file at '" << filename << "'.";
+    LINFO << msg;
+  };
+
+  try {
+    const auto deserializer = make_deserializer(ifstream, is_binary);
+    return SceneIndex(*deserializer, ROOT_POINTER);
+  } catch (const AbstractDeserializer::DeserializeError& deserialize_error) {
+    error_handler(deserialize_error.what());
+  } catch (const nlohmann::json::exception& exception) {
+    error_handler(exception.what());
+  }
+
+  return std::nullopt;
+}
+
+bool Scene::is_binary_file(const QString& filename)
+{
+  return QFileInfo(filename).suffix() == BinarySerializer::FILE_SUFFIX;
+}
+
 void Scene::reset()
 {
   set_selection({});
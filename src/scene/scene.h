@@ -2,6 +2,7 @@
 
 #include <map>
 #include <memory>
+#include <optional>
 #include <vector>
 #include <set>
 #include <cstdint>
@@ -14,6 +15,7 @@
 #include "cachedgetter.h"
 #include "scene/list.h"
 #include "scene/pointselection.h"
+#include "scene/sceneindex.h"
 
 namespace omm
 {
@@ -28,6 +30,8 @@ class MessageBox;
 class HistoryModel;
 class Animator;
 class NamedColors;
+class SpatialIndex;
+class DependencyGraph;
 class ColorProperty;
 
 template<typename T> struct SceneStructure;
@@ -63,8 +67,24 @@ private:
 
   // === Save/Load ====
 public:
+  /**
+   * @brief save_as and load_from use the binary format if the suffix of @code filename is
+   *  `BinarySerializer::FILE_SUFFIX` and JSON otherwise.
+   */
   bool save_as(const QString& filename);
-  bool load_from(const QString& filename);
+
+  /**
+   * @param filter if set, only the objects selected by `SceneIndex::closure(filter)` are loaded.
+   *  The other objects are skipped without being instantiated. Styles are always loaded.
+   */
+  bool load_from(const QString& filename, const SceneIndex::Predicate& filter = nullptr);
+
+  /**
+   * @brief index reads the outline of the object tree in @code filename.
+   * @return the index or std::nullopt if the file cannot be read.
+   */
+  static std::optional<SceneIndex> index(const QString& filename);
+  static bool is_binary_file(const QString& filename);
   QString filename() const;
 
   static constexpr auto TYPE = "Scene";
@@ -114,6 +134,15 @@ public:
   MessageBox& message_box() const { return *m_message_box; }
 
 
+  // === DependencyGraph ===
+private:
+  // objects unregister from the dependency graph when they are destroyed, i.e., it must outlive
+  // the object tree and the history.
+  std::unique_ptr<DependencyGraph> m_dependency_graph;
+public:
+  DependencyGraph& dependency_graph() const { return *m_dependency_graph; }
+
+
   // === Objects  ====
 private:
   std::unique_ptr<ObjectTree> m_object_tree;
@@ -169,6 +198,12 @@ public:
   NamedColors& named_colors() { return *m_named_colors; }
   std::set<ColorProperty*> find_named_color_holders(const QString& name) const;
 
+  // === SpatialIndex ===
+private:
+  std::unique_ptr<SpatialIndex> m_spatial_index;
+public:
+  SpatialIndex& spatial_index() const { return *m_spatial_index; }
+
 };
 
 }  // namespace omm
@@ -0,0 +1,156 @@
+#include "scene/sceneindex.h"
+#include "aspects/abstractpropertyowner.h"
+#include "animation/track.h"
+#include "objects/empty.h"
+#include "objects/object.h"
+#include "properties/referenceproperty.h"
+#include "serializers/abstractserializer.h"
+#include "tags/nodestag.h"
+
+namespace omm
+{
+
+SceneIndex::SceneIndex(AbstractDeserializer& deserializer, const Pointer& root_pointer)
+{
+  // the type of the root is not stored, it is always an `Empty`.
+  index(deserializer, Serializable::make_pointer(root_pointer), Empty::TYPE, std::nullopt);
+}
+
+QString SceneIndex::tree_path(std::size_t i) const
+{
+  const Entry& entry = m_entries.at(i);
+  const QString path = entry.parent ? tree_path(*entry.parent) : "";
+  return path + "/" + entry.name;
+}
+
+std::set<SceneIndex::Pointer> SceneIndex::closure(const Predicate& predicate) const
+{
+  std::set<std::size_t> selection;
+  std::vector<std::size_t> pending;
+  const auto select = [&selection, &pending](std::size_t i) {
+    if (selection.insert(i).second) {
+      pending.push_back(i);
+    }
+  };
+  const auto select_subtree = [this, &select](std::size_t i) {
+    std::vector<std::size_t> stack { i };
+    while (!stack.empty()) {
+      const std::size_t j = stack.back();
+      stack.pop_back();
+      select(j);
+      const auto& children = m_entries.at(j).children;
+      stack.insert(stack.end(), children.begin(), children.end());
+    }
+    for (auto parent = m_entries.at(i).parent; parent; parent = m_entries.at(*parent).parent) {
+      select(*parent);
+    }
+  };
+
+  select(0);
+  for (std::size_t i = 0; i < m_entries.size(); ++i) {
+    if (predicate(m_entries[i], tree_path(i))) {
+      select_subtree(i);
+    }
+  }
+
+  while (!pending.empty()) {
+    const std::size_t i = pending.back();
+    pending.pop_back();
+    for (const std::size_t id : m_entries.at(i).references) {
+      if (const auto it = m_owners.find(id); it != m_owners.end()) {
+        select_subtree(it->second);
+      }
+    }
+  }
+
+  std::set<Pointer> pointers;
+  for (const std::size_t i : selection) {
+    pointers.insert(m_entries.at(i).pointer);
+  }
+  return pointers;
+}
+
+void SceneIndex::index(AbstractDeserializer& deserializer, const Pointer& pointer,
+                       const QString& type, std::optional<std::size_t> parent)
+{
+  const std::size_t i = m_entries.size();
+  m_entries.push_back(Entry{ pointer, type, QString(), QStringList(), parent, {}, {} });
+  if (parent) {
+    m_entries.at(*parent).children.push_back(i);
+  }
+
+  const auto id_pointer = Serializable::make_pointer(pointer, AbstractPropertyOwner::ID_POINTER);
+  m_owners.insert({ deserializer.get_size_t(id_pointer), i });
+  index_properties(deserializer, pointer, i);
+
+  const auto tags_pointer = Serializable::make_pointer(pointer, Object::TAGS_POINTER);
+  const std::size_t n_tags = deserializer.array_size(tags_pointer);
+  for (std::size_t t = 0; t < n_tags; ++t) {
+    const auto tag_pointer = Serializable::make_pointer(tags_pointer, t);
+    const auto tag_type_pointer = Serializable::make_pointer(tag_pointer, Object::TYPE_POINTER);
+    const QString tag_type = deserializer.get_string(tag_type_pointer);
+    m_entries.at(i).tag_types.push_back(tag_type);
+    const auto tag_id_pointer = Serializable::make_pointer(tag_pointer,
+                                                           AbstractPropertyOwner::ID_POINTER);
+    m_owners.insert({ deserializer.get_size_t(tag_id_pointer), i });
+    index_properties(deserializer, tag_pointer, i);
+
+    if (tag_type == NodesTag::TYPE) {
+      // the nodes (e.g., `ReferenceNode`) may reference objects, too.
+      const auto nodes_pointer = Serializable::make_pointer(tag_pointer, NodesTag::NODES_POINTER,
+                                                            NodeModel::NODES_POINTER);
+      const std::size_t n_nodes = deserializer.array_size(nodes_pointer);
+      for (std::size_t n = 0; n < n_nodes; ++n) {
+        index_properties(deserializer, Serializable::make_pointer(nodes_pointer, n), i);
+      }
+    }
+  }
+
+  const auto children_pointer = Serializable::make_pointer(pointer, Object::CHILDREN_POINTER);
+  const std::size_t n_children = deserializer.array_size(children_pointer);
+  for (std::size_t c = 0; c < n_children; ++c) {
+    const auto child_pointer = Serializable::make_pointer(children_pointer, c);
+    const auto child_type_pointer = Serializable::make_pointer(child_pointer, Object::TYPE_POINTER);
+    index(deserializer, child_pointer, deserializer.get_string(child_type_pointer), i);
+  }
+}
+
+void SceneIndex::index_properties(AbstractDeserializer& deserializer, const Pointer& pointer,
+                                  std::size_t entry)
+{
+  using APO = AbstractPropertyOwner;
+  const auto properties_pointer = Serializable::make_pointer(pointer, APO::PROPERTIES_POINTER);
+  const std::size_t n_properties = deserializer.array_size(properties_pointer);
+  for (std::size_t p = 0; p < n_properties; ++p) {
+    const auto property_pointer = Serializable::make_pointer(properties_pointer, p);
+    const auto value_pointer = Serializable::make_pointer(property_pointer,
+                                                          TypedPropertyDetail::VALUE_POINTER);
+    const auto type_pointer = Serializable::make_pointer(property_pointer,
+                                                         APO::PROPERTY_TYPE_POINTER);
+    const auto key_pointer = Serializable::make_pointer(property_pointer,
+                                                        APO::PROPERTY_KEY_POINTER);
+    if (deserializer.get_string(type_pointer) == ReferenceProperty::TYPE()) {
+      auto& references = m_entries.at(entry).references;
+      references.insert(deserializer.get_size_t(value_pointer));
+      const auto is_animated_pointer = Serializable::make_pointer(property_pointer,
+                                                                  Property::IS_ANIMATED_POINTER);
+      if (deserializer.get_bool(is_animated_pointer)) {
+        const auto knots_pointer = Serializable::make_pointer(property_pointer,
+                                                              Property::TRACK_POINTER,
+                                                              Track::KNOTS_KEY);
+        const std::size_t n_knots = deserializer.array_size(knots_pointer);
+        for (std::size_t k = 0; k < n_knots; ++k) {
+          const auto knot_value_pointer = Serializable::make_pointer(knots_pointer, k,
+                                                                     Track::VALUE_KEY);
+          references.insert(deserializer.get_size_t(knot_value_pointer));
+        }
+      }
+    } else if (pointer == m_entries.at(entry).pointer
+               && deserializer.get_string(key_pointer) == APO::NAME_PROPERTY_KEY)
+    {
+      m_entries.at(entry).name = deserializer.get_string(value_pointer);
+    }
+  }
+}
+
+}  // namespace omm
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <functional>
+#include <map>
+#include <optional>
+#include <set>
+#include <vector>
+#include <QStringList>
+#include "aspects/serializable.h"
+
+namespace omm
+{
+
+class AbstractDeserializer;
+
+/**
+ * @brief The SceneIndex class is an outline of the object tree stored in a scene file.
+ *  It reads the type, name, tags and outgoing references of each object without instantiating
+ *  any object, property or tag. It is used to load only a part of a scene (see `closure`).
+ */
+class SceneIndex
+{
+public:
+  using Pointer = Serializable::Pointer;
+  SceneIndex(AbstractDeserializer& deserializer, const Pointer& root_pointer);
+
+  struct Entry
+  {
+    Pointer pointer;
+    QString type;
+    QString name;
+    QStringList tag_types;
+    std::optional<std::size_t> parent;
+    std::vector<std::size_t> children;
+
+    // the ids referenced by the properties, tags and nodes of the object, including animated
+    // references.
+    std::set<std::size_t> references;
+  };
+
+  /**
+   * @brief entries returns the objects in depth-first order. The first entry is the root.
+   *  Parents and children are referred by their index.
+   */
+  const std::vector<Entry>& entries() const { return m_entries; }
+
+  /**
+   * @brief tree_path returns the same as `Object::tree_path` of the object at @code i.
+   */
+  QString tree_path(std::size_t i) const;
+
+  using Predicate = std::function<bool(const Entry& entry, const QString& tree_path)>;
+
+  /**
+   * @brief closure returns the pointers of the objects which must be deserialized to
+   *  reproduce the objects matching @code predicate: the matching objects, their descendants and
+   *  ancestors and, recursively, the objects (or owners of the tags) referenced by any of them.
+   *  Styles are not indexed, references to them are ignored.
+   */
+  std::set<Pointer> closure(const Predicate& predicate) const;
+
+private:
+  std::vector<Entry> m_entries;
+
+  // maps the ids of the objects and of their tags to the index of the object.
+  std::map<std::size_t, std::size_t> m_owners;
+
+  void index(AbstractDeserializer& deserializer, const Pointer& pointer,
+             const QString& type, std::optional<std::size_t> parent);
+  void index_properties(AbstractDeserializer& deserializer, const Pointer& pointer,
+                        std::size_t entry);
+};
+
+}  // namespace omm
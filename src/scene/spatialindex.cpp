@@ -0,0 +1,125 @@
+#include "scene/spatialindex.h"
+#include "objects/object.h"
+#include "scene/messagebox.h"
+#include "scene/objecttree.h"
+#include "scene/scene.h"
+
+namespace
+{
+
+omm::BoundingBox bounding_box(const omm::Object& object)
+{
+  auto bounding_box = object.is_root() ? omm::BoundingBox() : object.scene_bounding_box();
+  return bounding_box | omm::SpatialIndex::origin(object);
+}
+
+}  // namespace
+
+namespace omm
+{
+
+SpatialIndex::SpatialIndex(Scene& scene) : m_scene(scene)
+{
+  MessageBox& message_box = m_scene.message_box();
+  connect(&message_box, qOverload<Object&>(&MessageBox::appearance_changed),
+          this, [this](Object& object)
+  {
+    mark_outdated(object, false);
+  });
+  connect(&message_box, &MessageBox::transformation_changed, this, [this](Object& object) {
+    // the root's transformation is the viewport transformation, it does not affect scene space.
+    if (!object.is_root()) {
+      mark_outdated(object, true);
+    }
+  });
+  connect(&message_box, &MessageBox::object_inserted, this, &SpatialIndex::invalidate);
+  connect(&message_box, &MessageBox::object_removed, this, &SpatialIndex::invalidate);
+  connect(&message_box, &MessageBox::object_moved, this, &SpatialIndex::invalidate);
+  connect(&message_box, &MessageBox::about_to_reset, this, &SpatialIndex::invalidate);
+  connect(&message_box, &MessageBox::scene_reseted, this, &SpatialIndex::invalidate);
+}
+
+std::vector<Object*> SpatialIndex::objects(const BoundingBox& region) const
+{
+  if (m_objects) {
+    update();
+  } else {
+    build();
+  }
+  return m_objects->query(region);
+}
+
+Vec2f SpatialIndex::origin(const Object& object)
+{
+  if (object.is_root()) {
+    return Vec2f::o();
+  } else {
+    return object.global_transformation(Space::Scene).null();
+  }
+}
+
+void SpatialIndex::invalidate()
+{
+  m_objects.reset();
+  m_indices.clear();
+  m_outdated_objects.clear();
+}
+
+void SpatialIndex::mark_outdated(Object& object, bool include_descendants)
+{
+  if (!m_objects) {
+    return;
+  }
+
+  // the scene bounding box of an object includes its descendants.
+  Object* o = &object;
+  m_outdated_objects.insert(o);
+  while (!o->is_root()) {
+    o = &o->tree_parent();
+    m_outdated_objects.insert(o);
+  }
+  if (include_descendants) {
+    const auto descendants = object.all_descendants();
+    m_outdated_objects.insert(descendants.begin(), descendants.end());
+  }
+}
+
+void SpatialIndex::build() const
+{
+  using Index = BoundingVolumeHierarchy<Object*>;
+  const auto objects = m_scene.object_tree().items();
+  std::vector<Index::Item> items;
+  items.reserve(objects.size());
+  m_indices.clear();
+  for (Object* object : objects) {
+    m_indices.insert({ object, items.size() });
+    items.push_back({ bounding_box(*object), object });
+  }
+  m_objects = Index(std::move(items));
+  m_outdated_objects.clear();
+  m_n_updates = 0;
+}
+
+void SpatialIndex::update() const
+{
+  // refitting keeps the structure of the hierarchy, which becomes inefficient if many objects
+  // moved. Rebuild it from time to time, the cost is amortized over the updates.
+  if (m_n_updates + m_outdated_objects.size() > m_indices.size()) {
+    build();
+    return;
+  }
+
+  for (Object* object : m_outdated_objects) {
+    // objects which are not in the tree, e.g., clones, are not indexed.
+    if (const auto it = m_indices.find(object); it != m_indices.end()) {
+      if (!m_objects->update(it->second, bounding_box(*object))) {
+        build();
+        return;
+      }
+    }
+  }
+  m_n_updates += m_outdated_objects.size();
+  m_outdated_objects.clear();
+}
+
+}  // namespace omm
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <QObject>
+#include <map>
+#include <optional>
+#include <set>
+#include <vector>
+#include "geometry/boundingvolumehierarchy.h"
+
+namespace omm
+{
+
+class Object;
+class Scene;
+
+/**
+ * @brief The SpatialIndex class finds the objects of a scene at a position quickly.
+ *  Each object is indexed by its scene bounding box joined with its origin (in scene
+ *  coordinates). The `MessageBox` signals which indicate that an object's geometry or
+ *  transformation changed mark the affected objects as outdated, their boxes are refitted on the
+ *  next query. The index is rebuilt if objects are inserted, removed or moved in the tree, or if
+ *  it has been refitted so often that it is probably degenerated.
+ */
+class SpatialIndex : public QObject
+{
+  Q_OBJECT
+public:
+  explicit SpatialIndex(Scene& scene);
+
+  /**
+   * @brief objects returns the objects whose scene bounding box or origin intersects @code region.
+   * @param region the region in scene coordinates.
+   */
+  std::vector<Object*> objects(const BoundingBox& region) const;
+
+  /**
+   * @brief origin returns the origin of @code object in scene coordinates.
+   */
+  static Vec2f origin(const Object& object);
+
+public Q_SLOTS:
+  void invalidate();
+
+private:
+  Scene& m_scene;
+  mutable std::optional<BoundingVolumeHierarchy<Object*>> m_objects;
+
+  // the index of each object in the items the hierarchy was built from.
+  mutable std::map<const Object*, std::size_t> m_indices;
+  mutable std::set<Object*> m_outdated_objects;
+  mutable std::size_t m_n_updates = 0;
+
+  void mark_outdated(Object& object, bool include_descendants);
+  void build() const;
+  void update() const;
+};
+
+}  // namespace omm
@@ -21,12 +21,14 @@ TagList::TagList(const TagList &other, Object& object)
 void TagList::insert(ListOwningContext<Tag> &context)
 {
   List<Tag>::insert(context);
+  m_object.styles.invalidate();
   Q_EMIT scene().message_box().tag_inserted(m_object, context.get_subject());
 }
 
 void TagList::remove(ListOwningContext<Tag> &t)
 {
   List<Tag>::remove(t);
+  m_object.styles.invalidate();
   Q_EMIT scene().message_box().tag_removed(m_object, t.get_subject());
 }
 
@@ -34,6 +36,7 @@ std::unique_ptr<Tag> TagList::remove(Tag &tag)
 {
   Object& owner = *tag.owner;
   auto otag = List<Tag>::remove(tag);
+  owner.styles.invalidate();
   Q_EMIT scene().message_box().tag_removed(owner, tag);
   return otag;
 }
@@ -44,6 +47,13 @@ void TagList::move(ListMoveContext<Tag> &context)
   Q_UNREACHABLE();
 }
 
+std::vector<std::unique_ptr<Tag>> TagList::set(std::vector<std::unique_ptr<Tag>> items)
+{
+  auto old_items = List<Tag>::set(std::move(items));
+  m_object.styles.invalidate();
+  return old_items;
+}
+
 Scene &TagList::scene()
 {
   return *m_object.scene();
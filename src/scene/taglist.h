@@ -18,6 +18,7 @@ public:
   void remove(ListOwningContext<Tag> &t) override;
   std::unique_ptr<Tag> remove(Tag& tag) override;
   void move(ListMoveContext<Tag> &context) override;
+  std::vector<std::unique_ptr<Tag>> set(std::vector<std::unique_ptr<Tag>> items) override;
   Scene& scene();
 
 private:
@@ -9,6 +9,7 @@
 #include "tags/tag.h"
 #include "objects/object.h"
 #include "properties/referenceproperty.h"
+#include "geometry/point.h"
 
 namespace omm
 {
@@ -29,6 +30,15 @@ void AbstractSerializer::set_value(const Serializable& serializable, const Abstr
   serializable.serialize(*this, pointer);
 }
 
+void AbstractSerializer::set_points(const std::vector<Point>& points, const Pointer& pointer)
+{
+  start_array(points.size(), pointer);
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    points[i].serialize(*this, Serializable::make_pointer(pointer, i));
+  }
+  end_array();
+}
+
 std::set<omm::AbstractPropertyOwner*> AbstractSerializer::serialized_references() const
 {
   return m_serialized_references;
@@ -45,6 +55,15 @@ AbstractDeserializer::~AbstractDeserializer()
 {
 }
 
+std::vector<Point> AbstractDeserializer::get_points(const Pointer& pointer)
+{
+  std::vector<Point> points(array_size(pointer));
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    points[i].deserialize(*this, Serializable::make_pointer(pointer, i));
+  }
+  return points;
+}
+
 void AbstractDeserializer::polish()
 {
   // polish reference properties
@@ -75,6 +94,30 @@ void AbstractDeserializer::register_reference_polisher(ReferencePolisher &polish
   m_reference_polishers.insert(&polisher);
 }
 
+void AbstractDeserializer::restrict_objects(std::set<Pointer> pointers)
+{
+  m_object_pointers = std::move(pointers);
+}
+
+bool AbstractDeserializer::accepts_object(const Pointer& pointer) const
+{
+  return !m_object_pointers || ::contains(*m_object_pointers, pointer);
+}
+
+std::vector<AbstractDeserializer::Pointer>
+AbstractDeserializer::accepted_objects(const Pointer& children_pointer)
+{
+  std::vector<Pointer> pointers;
+  const std::size_t n_children = array_size(children_pointer);
+  for (std::size_t i = 0; i < n_children; ++i) {
+    const auto child_pointer = Serializable::make_pointer(children_pointer, i);
+    if (accepts_object(child_pointer)) {
+      pointers.push_back(child_pointer);
+    }
+  }
+  return pointers;
+}
+
 void AbstractDeserializer::get(Serializable& serializable, const AbstractDeserializer::Pointer& pointer)
 {
   serializable.deserialize(*this, pointer);
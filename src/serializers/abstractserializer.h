@@ -2,6 +2,9 @@
 
 #include <QObject>
 #include <iosfwd>
+#include <optional>
+#include <set>
+#include <vector>
 #include <unordered_map>
 
 #include "abstractfactory.h"
@@ -16,6 +19,7 @@ namespace omm
 {
 
 class ObjectTransformation;
+class Point;
 class Scene;
 class ReferenceProperty;
 class AbstractPropertyOwner;
@@ -52,6 +56,12 @@ public:
   virtual void set_value(const TriggerPropertyDummyValueType&, const Pointer& pointer) = 0;
   virtual void set_value(const SplineType&, const Pointer& pointer) = 0;
   void set_value(const AbstractPropertyOwner* id, const Pointer& pointer);
+
+  /**
+   * @brief set_points stores @code points as an array at @code pointer.
+   *  Serializers may override it to store all points as a single block.
+   */
+  virtual void set_points(const std::vector<Point>& points, const Pointer& pointer);
   void set_value(const variant_type& variant, const Pointer& pointer);
   void set_value(const Serializable& serializable, const Pointer& pointer);
   template<typename T> std::enable_if_t<std::is_enum_v<T>> set_value(const T& t, const Pointer& ptr)
@@ -125,9 +135,35 @@ public:
   virtual TriggerPropertyDummyValueType get_trigger_dummy_value(const Pointer& pointer) = 0;
   virtual SplineType get_spline(const Pointer& pointer) = 0;
 
+  /**
+   * @brief get_points reads the points stored by `AbstractSerializer::set_points`.
+   */
+  virtual std::vector<Point> get_points(const Pointer& pointer);
+
   void register_reference(const std::size_t id, AbstractPropertyOwner& reference);
   void register_reference_polisher(ReferencePolisher& polisher);
 
+  /**
+   * @brief restrict_objects makes `Object::deserialize` skip the children whose pointer is not in
+   *  @code pointers. By default, all objects are deserialized.
+   */
+  void restrict_objects(std::set<Pointer> pointers);
+  bool accepts_object(const Pointer& pointer) const;
+
+  /**
+   * @brief accepted_objects returns the pointers of the elements of the array at
+   *  @code children_pointer which are accepted (see `restrict_objects`), in order.
+   *  `Object::deserialize` deserializes exactly these children.
+   */
+  std::vector<Pointer> accepted_objects(const Pointer& children_pointer);
+
+  /**
+   * @brief decode prepares the independent subtrees at @code pointers to be read, e.g., on worker
+   *  threads. It does not instantiate anything, that happens when the subtrees are deserialized.
+   *  The default implementation does nothing.
+   */
+  virtual void decode(const std::vector<Pointer>& pointers) { Q_UNUSED(pointers) }
+
   template<typename T> std::enable_if_t<!std::is_enum_v<T>, T> get(const Pointer&);
   template<typename T> std::enable_if_t<std::is_enum_v<T>, T> get(const Pointer& pointer)
   {
@@ -184,6 +220,7 @@ private:
   // maps old stored hash to new ref
   std::map<std::size_t, AbstractPropertyOwner*> m_id_to_reference;
   std::set<ReferencePolisher*> m_reference_polishers;
+  std::optional<std::set<Pointer>> m_object_pointers;
 };
 
 }  // namespace omm
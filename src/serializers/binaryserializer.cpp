@@ -0,0 +1,389 @@
+#include "serializers/binaryserializer.h"
+#include <QtEndian>
+#include <array>
+#include <cstring>
+#include <istream>
+#include <ostream>
+
+namespace
+{
+
+using Type = omm::BinarySerializer::Type;
+
+template<typename T> void write(std::ostream& ostream, T value)
+{
+  value = qToLittleEndian(value);
+  ostream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void write_double(std::ostream& ostream, double value)
+{
+  static_assert(sizeof(double) == sizeof(quint64));
+  quint64 bits = 0;
+  std::memcpy(&bits, &value, sizeof(bits));
+  write(ostream, bits);
+}
+
+void write_string(std::ostream& ostream, const QString& string)
+{
+  const QByteArray utf8 = string.toUtf8();
+  write(ostream, static_cast<quint32>(utf8.size()));
+  ostream.write(utf8.constData(), utf8.size());
+}
+
+template<typename T> T read(std::istream& istream)
+{
+  T value;
+  if (!istream.read(reinterpret_cast<char*>(&value), sizeof(T))) {
+    throw omm::AbstractDeserializer::DeserializeError("Unexpected end of file.");
+  }
+  return qFromLittleEndian(value);
+}
+
+double read_double(std::istream& istream)
+{
+  const auto bits = read<quint64>(istream);
+  double value = 0.0;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+QString read_string(std::istream& istream)
+{
+  QByteArray utf8(static_cast<int>(read<quint32>(istream)), Qt::Uninitialized);
+  if (!istream.read(utf8.data(), utf8.size())) {
+    throw omm::AbstractDeserializer::DeserializeError("Unexpected end of file.");
+  }
+  return QString::fromUtf8(utf8);
+}
+
+}  // namespace
+
+namespace omm
+{
+
+BinarySerializer::BinarySerializer(std::ostream& ostream)
+  : AbstractSerializer(ostream)
+  , m_ostream(ostream)
+{
+  m_ostream.write(MAGIC, sizeof(MAGIC));
+  write(m_ostream, VERSION);
+}
+
+BinarySerializer::~BinarySerializer()
+{
+  write(m_ostream, static_cast<quint8>(Type::End));
+}
+
+void BinarySerializer::start_record(Type type, const Pointer& pointer)
+{
+  write(m_ostream, static_cast<quint8>(type));
+  write_string(m_ostream, pointer);
+}
+
+void BinarySerializer::start_array(size_t size, const Pointer& pointer)
+{
+  start_record(Type::Array, pointer);
+  write(m_ostream, static_cast<quint64>(size));
+}
+
+void BinarySerializer::end_array()
+{
+  // no action required
+}
+
+void BinarySerializer::set_value(int value, const Pointer& pointer)
+{
+  start_record(Type::Int, pointer);
+  write(m_ostream, static_cast<qint32>(value));
+}
+
+void BinarySerializer::set_value(bool value, const Pointer& pointer)
+{
+  start_record(Type::Bool, pointer);
+  write(m_ostream, static_cast<quint8>(value));
+}
+
+void BinarySerializer::set_value(double value, const Pointer& pointer)
+{
+  start_record(Type::Double, pointer);
+  write_double(m_ostream, value);
+}
+
+void BinarySerializer::set_value(const QString& value, const Pointer& pointer)
+{
+  start_record(Type::String, pointer);
+  write_string(m_ostream, value);
+}
+
+void BinarySerializer::set_value(const std::size_t value, const Pointer& pointer)
+{
+  start_record(Type::SizeT, pointer);
+  write(m_ostream, static_cast<quint64>(value));
+}
+
+void BinarySerializer::set_value(const Color& color, const Pointer& pointer)
+{
+  start_record(Type::Color, pointer);
+  const bool is_named = color.model() == Color::Model::Named;
+  write(m_ostream, static_cast<quint8>(is_named));
+  if (is_named) {
+    write_string(m_ostream, color.name());
+  } else {
+    for (const double component : color.components(Color::Model::RGBA)) {
+      write_double(m_ostream, component);
+    }
+  }
+}
+
+void BinarySerializer::set_value(const Vec2f& value, const Pointer& pointer)
+{
+  start_record(Type::Vec2f, pointer);
+  write_double(m_ostream, value[0]);
+  write_double(m_ostream, value[1]);
+}
+
+void BinarySerializer::set_value(const Vec2i& value, const Pointer& pointer)
+{
+  start_record(Type::Vec2i, pointer);
+  write(m_ostream, static_cast<qint32>(value[0]));
+  write(m_ostream, static_cast<qint32>(value[1]));
+}
+
+void BinarySerializer::set_value(const PolarCoordinates& value, const Pointer& pointer)
+{
+  set_value(Vec2f(value.argument, value.magnitude), pointer);
+}
+
+void BinarySerializer::set_value(const TriggerPropertyDummyValueType&, const Pointer& pointer)
+{
+  Q_UNUSED(pointer)
+}
+
+void BinarySerializer::set_value(const SplineType& spline, const Pointer& pointer)
+{
+  start_record(Type::Spline, pointer);
+  write(m_ostream, static_cast<quint64>(spline.knots.size()));
+  for (const auto& [t, knot] : spline.knots) {
+    write_double(m_ostream, t);
+    write_double(m_ostream, knot.value);
+    write_double(m_ostream, knot.left_offset);
+    write_double(m_ostream, knot.right_offset);
+  }
+}
+
+void BinarySerializer::set_points(const std::vector<Point>& points, const Pointer& pointer)
+{
+  start_record(Type::Points, pointer);
+  write(m_ostream, static_cast<quint64>(points.size()));
+  for (const Point& point : points) {
+    write_double(m_ostream, point.position.x);
+    write_double(m_ostream, point.position.y);
+    write_double(m_ostream, point.left_tangent.argument);
+    write_double(m_ostream, point.left_tangent.magnitude);
+    write_double(m_ostream, point.right_tangent.argument);
+    write_double(m_ostream, point.right_tangent.magnitude);
+  }
+}
+
+BinaryDeserializer::BinaryDeserializer(std::istream& istream)
+  : AbstractDeserializer(istream)
+{
+  char magic[sizeof(BinarySerializer::MAGIC)];
+  if (!istream.read(magic, sizeof(magic))
+      || std::memcmp(magic, BinarySerializer::MAGIC, sizeof(magic)) != 0)
+  {
+    throw DeserializeError("Not an ommpfritt binary file.");
+  }
+  if (const auto version = read<quint32>(istream); version != BinarySerializer::VERSION) {
+    throw DeserializeError(QString("Unsupported version: %1.").arg(version).toStdString());
+  }
+
+  while (true) {
+    const auto type = static_cast<Type>(read<quint8>(istream));
+    if (type == Type::End) {
+      break;
+    }
+    const QString pointer = read_string(istream);
+    switch (type) {
+    case Type::Bool:
+      m_values.insert(pointer, read<quint8>(istream) != 0);
+      break;
+    case Type::Int:
+      m_values.insert(pointer, static_cast<int>(read<qint32>(istream)));
+      break;
+    case Type::Double:
+      m_values.insert(pointer, read_double(istream));
+      break;
+    case Type::String:
+      m_values.insert(pointer, read_string(istream));
+      break;
+    case Type::SizeT:
+      m_values.insert(pointer, static_cast<std::size_t>(read<quint64>(istream)));
+      break;
+    case Type::Color:
+      if (read<quint8>(istream) != 0) {
+        m_values.insert(pointer, Color(read_string(istream)));
+      } else {
+        std::array<double, 4> rgba;
+        for (double& component : rgba) {
+          component = read_double(istream);
+        }
+        m_values.insert(pointer, Color(Color::Model::RGBA, rgba));
+      }
+      break;
+    case Type::Vec2f:
+    {
+      const double x = read_double(istream);
+      m_values.insert(pointer, Vec2f(x, read_double(istream)));
+      break;
+    }
+    case Type::Vec2i:
+    {
+      const int x = read<qint32>(istream);
+      m_values.insert(pointer, Vec2i(x, read<qint32>(istream)));
+      break;
+    }
+    case Type::Spline:
+    {
+      SplineType::knot_map_type knots;
+      for (auto n = read<quint64>(istream); n > 0; --n) {
+        const double t = read_double(istream);
+        const double value = read_double(istream);
+        const double left_offset = read_double(istream);
+        const double right_offset = read_double(istream);
+        knots.insert({ t, SplineType::Knot(value, left_offset, right_offset) });
+      }
+      m_values.insert(pointer, SplineType(knots));
+      break;
+    }
+    case Type::Array:
+      m_values.insert(pointer, ArraySize{ static_cast<std::size_t>(read<quint64>(istream)) });
+      break;
+    case Type::Points:
+    {
+      std::vector<Point> points(read<quint64>(istream));
+      for (Point& point : points) {
+        point.position.x = read_double(istream);
+        point.position.y = read_double(istream);
+        point.left_tangent.argument = read_double(istream);
+        point.left_tangent.magnitude = read_double(istream);
+        point.right_tangent.argument = read_double(istream);
+        point.right_tangent.magnitude = read_double(istream);
+      }
+      m_values.insert(pointer, std::move(points));
+      break;
+    }
+    default:
+      throw DeserializeError(QString("Unknown record type %1 at '%2'.")
+                             .arg(static_cast<int>(type)).arg(pointer).toStdString());
+    }
+  }
+}
+
+const BinaryDeserializer::Value& BinaryDeserializer::value(const Pointer& pointer) const
+{
+  const auto it = m_values.find(pointer);
+  if (it == m_values.end()) {
+    throw DeserializeError("Cannot find '" + pointer.toStdString() + "'.");
+  }
+  return *it;
+}
+
+template<typename T> const T& BinaryDeserializer::value(const Pointer& pointer) const
+{
+  if (const T* value = std::get_if<T>(&this->value(pointer)); value != nullptr) {
+    return *value;
+  } else {
+    throw DeserializeError("Unexpected type at '" + pointer.toStdString() + "'.");
+  }
+}
+
+template<typename T> T BinaryDeserializer::number(const Pointer& pointer) const
+{
+  // like json, the numeric types are interchangeable.
+  return std::visit([pointer](auto&& value) -> T {
+    using V = std::decay_t<decltype(value)>;
+    if constexpr (std::is_arithmetic_v<V>) {
+      return static_cast<T>(value);
+    } else {
+      throw DeserializeError("Expected number at '" + pointer.toStdString() + "'.");
+    }
+  }, value(pointer));
+}
+
+size_t BinaryDeserializer::array_size(const Pointer& pointer)
+{
+  // like json, a missing array is empty.
+  if (const auto it = m_values.find(pointer); it == m_values.end()) {
+    return 0;
+  } else if (const auto* points = std::get_if<std::vector<Point>>(&*it); points != nullptr) {
+    return points->size();
+  } else {
+    return value<ArraySize>(pointer).size;
+  }
+}
+
+int BinaryDeserializer::get_int(const Pointer& pointer)
+{
+  return number<int>(pointer);
+}
+
+double BinaryDeserializer::get_double(const Pointer& pointer)
+{
+  return number<double>(pointer);
+}
+
+bool BinaryDeserializer::get_bool(const Pointer& pointer)
+{
+  return number<bool>(pointer);
+}
+
+QString BinaryDeserializer::get_string(const Pointer& pointer)
+{
+  return value<QString>(pointer);
+}
+
+Color BinaryDeserializer::get_color(const Pointer& pointer)
+{
+  return value<Color>(pointer);
+}
+
+std::size_t BinaryDeserializer::get_size_t(const Pointer& pointer)
+{
+  return number<std::size_t>(pointer);
+}
+
+Vec2f BinaryDeserializer::get_vec2f(const Pointer& pointer)
+{
+  return value<Vec2f>(pointer);
+}
+
+Vec2i BinaryDeserializer::get_vec2i(const Pointer& pointer)
+{
+  return value<Vec2i>(pointer);
+}
+
+PolarCoordinates BinaryDeserializer::get_polarcoordinates(const Pointer& pointer)
+{
+  const auto pair = get_vec2f(pointer);
+  return PolarCoordinates(pair[0], pair[1]);
+}
+
+TriggerPropertyDummyValueType BinaryDeserializer::get_trigger_dummy_value(const Pointer& pointer)
+{
+  Q_UNUSED(pointer)
+  return TriggerPropertyDummyValueType();
+}
+
+SplineType BinaryDeserializer::get_spline(const Pointer& pointer)
+{
+  return value<SplineType>(pointer);
+}
+
+std::vector<Point> BinaryDeserializer::get_points(const Pointer& pointer)
+{
+  return value<std::vector<Point>>(pointer);
+}
+
+}  // namespace omm
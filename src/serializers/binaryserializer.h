@@ -0,0 +1,89 @@
+#pragma once
+
+#include <QHash>
+#include <variant>
+#include "serializers/abstractserializer.h"
+#include "geometry/point.h"
+#include "splinetype.h"
+
+namespace omm
+{
+
+/**
+ * @brief The BinarySerializer class writes the binary scene format (`.ommb`).
+ *  The file starts with a header (magic number and version), followed by a sequence of records
+ *  and an end marker. A record consists of the type, the pointer and the value. Strings are
+ *  length-prefixed, numbers are stored in little endian. Point arrays are stored as a single block
+ *  of float64 values.
+ *  Unlike the `JSONSerializer`, it writes each value immediately and does not build a document.
+ */
+class BinarySerializer : public AbstractSerializer
+{
+public:
+  explicit BinarySerializer(std::ostream& ostream);
+  ~BinarySerializer();
+
+  static constexpr auto FILE_SUFFIX = "ommb";
+  static constexpr char MAGIC[4] = { 'O', 'M', 'M', 'B' };
+  static constexpr quint32 VERSION = 1;
+
+  enum class Type : quint8 { End = 0, Bool, Int, Double, String, SizeT, Color, Vec2f, Vec2i,
+                             Spline, Array, Points };
+
+  void start_array(size_t size, const Pointer& pointer) override;
+  void end_array() override;
+  void set_value(int value, const Pointer& pointer) override;
+  void set_value(bool value, const Pointer& pointer) override;
+  void set_value(double value, const Pointer& pointer) override;
+  void set_value(const QString& value, const Pointer& pointer) override;
+  void set_value(const std::size_t value, const Pointer& pointer) override;
+  void set_value(const Color& color, const Pointer& pointer) override;
+  void set_value(const Vec2f& value, const Pointer& pointer) override;
+  void set_value(const Vec2i& value, const Pointer& pointer) override;
+  void set_value(const PolarCoordinates& value, const Pointer& pointer) override;
+  void set_value(const TriggerPropertyDummyValueType&, const Pointer& pointer) override;
+  void set_value(const SplineType& spline, const Pointer& pointer) override;
+  void set_points(const std::vector<Point>& points, const Pointer& pointer) override;
+
+private:
+  std::ostream& m_ostream;
+  void start_record(Type type, const Pointer& pointer);
+};
+
+class BinaryDeserializer : public AbstractDeserializer
+{
+public:
+  explicit BinaryDeserializer(std::istream& istream);
+
+  size_t array_size(const Pointer& pointer) override;
+  int get_int(const Pointer& pointer) override;
+  double get_double(const Pointer& pointer) override;
+  bool get_bool(const Pointer& pointer) override;
+  QString get_string(const Pointer& pointer) override;
+  Color get_color(const Pointer& pointer) override;
+  std::size_t get_size_t(const Pointer& pointer) override;
+  Vec2f get_vec2f(const Pointer& pointer) override;
+  Vec2i get_vec2i(const Pointer& pointer) override;
+  PolarCoordinates get_polarcoordinates(const Pointer& pointer) override;
+  TriggerPropertyDummyValueType get_trigger_dummy_value(const Pointer& pointer) override;
+  SplineType get_spline(const Pointer& pointer) override;
+  std::vector<Point> get_points(const Pointer& pointer) override;
+
+private:
+  struct ArraySize
+  {
+    std::size_t size;
+  };
+
+  using Value = std::variant<bool, int, double, QString, std::size_t, Color, Vec2f, Vec2i,
+                             SplineType, ArraySize, std::vector<Point>>;
+
+  // the whole file is read upfront. Pointers are looked up in a hash rather than parsed.
+  QHash<Pointer, Value> m_values;
+
+  const Value& value(const Pointer& pointer) const;
+  template<typename T> const T& value(const Pointer& pointer) const;
+  template<typename T> T number(const Pointer& pointer) const;
+};
+
+}  // namespace omm
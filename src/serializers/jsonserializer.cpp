@@ -1,7 +1,10 @@
 #include "serializers/jsonserializer.h"
 
 #include "logging.h"
+#include <functional>
 #include <typeinfo>
+#include <QRunnable>
+#include <QThreadPool>
 #include "common.h"
 #include "aspects/serializable.h"
 
@@ -49,44 +52,70 @@ auto ptr(const omm::Serializable::Pointer& pointer)
 }
 
 template<typename T>
-T get_t(const nlohmann::json& json, const nlohmann::json::json_pointer& pointer)
+T get_t(const nlohmann::json& value, const omm::Serializable::Pointer& pointer)
 {
   try {
-    const auto value = json.at(pointer);
-    try {
-      if constexpr (std::is_same_v<T, double>) {
-        // get inf properly
-        return get_double(value);
-      } else if constexpr (std::is_same_v<T, std::vector<double>>) {
-        return ::transform<double, std::vector>(value, get_double);
-      } else if constexpr (std::is_same_v<T, QString>) {
-        return QString::fromStdString(value);
-      } else {
-        return value;
-      }
-    } catch (const nlohmann::json::type_error& convert_exception) {
-      std::ostringstream message;
-      message << "Failed to convert\n";
-      message << value << "\n";
-      message << "at '" << pointer << "'\n";
-      message << "to '" << typeid(T).name() << "'.";
-      throw omm::AbstractDeserializer::DeserializeError(message.str());
+    if constexpr (std::is_same_v<T, double>) {
+      // get inf properly
+      return get_double(value);
+    } else if constexpr (std::is_same_v<T, std::vector<double>>) {
+      return ::transform<double, std::vector>(value, get_double);
+    } else if constexpr (std::is_same_v<T, QString>) {
+      return QString::fromStdString(value);
+    } else {
+      return value;
+    }
+  } catch (const nlohmann::json::type_error& convert_exception) {
+    std::ostringstream message;
+    message << "Failed to convert\n";
+    message << value << "\n";
+    message << "at '" << pointer.toStdString() << "'\n";
+    message << "to '" << typeid(T).name() << "'.";
+    throw omm::AbstractDeserializer::DeserializeError(message.str());
+  }
+}
+
+/**
+ * @brief unescape undoes the escaping of a JSON pointer token (RFC 6901).
+ */
+std::string unescape(const QStringRef& token)
+{
+  std::string unescaped = token.toString().toStdString();
+  const auto replace_all = [&unescaped](const std::string& escaped, const std::string& raw) {
+    for (auto i = unescaped.find(escaped); i != std::string::npos; i = unescaped.find(escaped, i)) {
+      unescaped.replace(i, escaped.size(), raw);
     }
-  } catch (const nlohmann::json::out_of_range& json_exception) {
-    throw omm::AbstractDeserializer::DeserializeError(
-      "Cannot find '" + std::string(pointer) + "'.");
-  } catch (const nlohmann::json::parse_error& json_exception) {
-    throw omm::AbstractDeserializer::DeserializeError(
-      "Invalid pointer '" + std::string(pointer) + "'.");
+  };
+  if (unescaped.find('~') != std::string::npos) {
+    // `~1` must be replaced first, see RFC 6901.
+    replace_all("~1", "/");
+    replace_all("~0", "~");
   }
+  return unescaped;
 }
 
-template<typename T, typename PointerT>
-T get_t(const nlohmann::json& json, const PointerT& pointer)
+bool is_double(const nlohmann::json& json_val)
 {
-  return get_t<T>(json, nlohmann::json::json_pointer(pointer.toStdString()));
+  if (json_val.is_number()) {
+    return true;
+  } else if (json_val.is_string()) {
+    const std::string& value = json_val.get_ref<const std::string&>();
+    return value == inf_value || value == neg_inf_value;
+  } else {
+    return false;
+  }
 }
 
+class Task : public QRunnable
+{
+public:
+  explicit Task(std::function<void()> function) : m_function(std::move(function)) {}
+  void run() override { m_function(); }
+
+private:
+  const std::function<void()> m_function;
+};
+
 }  // namespace
 
 namespace omm
@@ -198,43 +227,161 @@ JSONDeserializer::JSONDeserializer(std::istream& istream)
   } catch (const nlohmann::detail::parse_error& error) {
     throw omm::AbstractDeserializer::DeserializeError(error.what());
   }
+  m_cursor.push_back({ QString(), &m_store });
+}
+
+void JSONDeserializer::decode(const std::vector<Pointer>& pointers)
+{
+  std::vector<Records> records(pointers.size());
+  QThreadPool pool;
+  for (std::size_t i = 0; i < pointers.size(); ++i) {
+    // the subtrees are located on this thread, the cursor must not be shared.
+    if (const nlohmann::json* node = find(pointers[i]); node != nullptr) {
+      pool.start(new Task([node, pointer=pointers[i], &records=records[i]]() {
+        JSONDeserializer::decode(*node, pointer, records);
+      }));
+    }
+  }
+  pool.waitForDone();
+
+  for (const Records& subtree_records : records) {
+    for (auto it = subtree_records.begin(); it != subtree_records.end(); ++it) {
+      m_records.insert(it.key(), it.value());
+    }
+  }
+}
+
+void JSONDeserializer::decode(const nlohmann::json& node, const Pointer& pointer,
+                              Records& records)
+{
+  Record record{ &node, std::nullopt, std::nullopt };
+  if (node.is_string()) {
+    record.string = QString::fromStdString(node.get_ref<const std::string&>());
+  } else if (node.is_array() && !node.empty() && std::all_of(node.begin(), node.end(), is_double)) {
+    // vectors and colors are read as a whole, their elements are not recorded.
+    record.numbers = ::transform<double, std::vector>(node, ::get_double);
+  } else if (node.is_array()) {
+    for (std::size_t i = 0; i < node.size(); ++i) {
+      decode(node[i], Serializable::make_pointer(pointer, i), records);
+    }
+  } else if (node.is_object()) {
+    for (auto it = node.begin(); it != node.end(); ++it) {
+      const QString key = QString::fromStdString(it.key());
+      // pointers are not escaped (see `Serializable::make_pointer`). Nodes below such keys are
+      // not recorded, they are found in the document.
+      if (!key.contains('/') && !key.contains('~')) {
+        decode(it.value(), pointer + '/' + key, records);
+      }
+    }
+  }
+  records.insert(pointer, std::move(record));
+}
+
+const JSONDeserializer::Record* JSONDeserializer::record(const Pointer& pointer) const
+{
+  if (const auto it = m_records.constFind(pointer); it != m_records.cend()) {
+    return &*it;
+  } else {
+    return nullptr;
+  }
+}
+
+const nlohmann::json* JSONDeserializer::find(const Pointer& pointer)
+{
+  if (const Record* record = this->record(pointer); record != nullptr) {
+    return record->node;
+  }
+
+  const QVector<QStringRef> tokens = pointer.splitRef('/');
+  if (tokens.isEmpty() || !tokens.front().isEmpty()) {
+    throw DeserializeError("Invalid pointer '" + pointer.toStdString() + "'.");
+  }
+
+  // the deserializers read the document depth-first, hence consecutive pointers share a long
+  // prefix. Only the tokens after the common prefix need to be resolved.
+  std::size_t depth = 1;
+  while (depth < m_cursor.size() && static_cast<int>(depth) < tokens.size()
+         && m_cursor[depth].token == tokens[static_cast<int>(depth)])
+  {
+    depth += 1;
+  }
+  m_cursor.resize(depth);
+
+  for (int i = static_cast<int>(depth); i < tokens.size(); ++i) {
+    const nlohmann::json& node = *m_cursor.back().node;
+    const nlohmann::json* child = nullptr;
+    if (node.is_object()) {
+      if (const auto it = node.find(unescape(tokens[i])); it != node.end()) {
+        child = &*it;
+      }
+    } else if (node.is_array()) {
+      bool ok = false;
+      const std::size_t index = tokens[i].toULongLong(&ok);
+      if (ok && index < node.size()) {
+        child = &node[index];
+      }
+    }
+    if (child == nullptr) {
+      return nullptr;
+    }
+    m_cursor.push_back({ tokens[i].toString(), child });
+  }
+  return m_cursor.back().node;
+}
+
+const nlohmann::json& JSONDeserializer::at(const Pointer& pointer)
+{
+  if (const nlohmann::json* node = find(pointer); node != nullptr) {
+    return *node;
+  } else {
+    throw DeserializeError("Cannot find '" + pointer.toStdString() + "'.");
+  }
 }
 
 size_t JSONDeserializer::array_size(const Pointer& pointer)
 {
-  const auto array = m_store[ptr(pointer)];
-  if (array.is_array() || array.is_null()) {
-    return array.size();
+  const nlohmann::json* array = find(pointer);
+  if (array == nullptr || array->is_null()) {
+    return 0;
+  } else if (array->is_array()) {
+    return array->size();
   } else {
-    const std::string dump = array.dump(4);
+    const std::string dump = array->dump(4);
     throw omm::AbstractDeserializer::DeserializeError("Expected array, got " + dump);
   }
 }
 
 int JSONDeserializer::get_int(const Pointer& pointer)
 {
-  return get_t<int>(m_store, pointer);
+  return get_t<int>(at(pointer), pointer);
 }
 
 bool JSONDeserializer::get_bool(const Pointer& pointer)
 {
-  return get_t<bool>(m_store, pointer);
+  return get_t<bool>(at(pointer), pointer);
 }
 
 double JSONDeserializer::get_double(const Pointer& pointer)
 {
-  return get_t<double>(m_store, pointer);
+  return get_t<double>(at(pointer), pointer);
 }
 
 QString JSONDeserializer::get_string(const Pointer& pointer)
 {
-  return get_t<QString>(m_store, pointer);
+  if (const Record* record = this->record(pointer); record != nullptr && record->string) {
+    return *record->string;
+  }
+  return get_t<QString>(at(pointer), pointer);
 }
 
 Color JSONDeserializer::get_color(const Pointer& pointer)
 {
   try {
-    const auto v = get_t<std::vector<double>>(m_store, Serializable::make_pointer(pointer, "rgba"));
+    const auto rgba_pointer = Serializable::make_pointer(pointer, "rgba");
+    const Record* record = this->record(rgba_pointer);
+    const auto v = record != nullptr && record->numbers
+        ? *record->numbers
+        : get_t<std::vector<double>>(at(rgba_pointer), rgba_pointer);
     const auto n = get_string(Serializable::make_pointer(pointer, "name"));
     if (n.isEmpty()) {
       return Color(Color::Model::RGBA, { v.at(0), v.at(1), v.at(2), v.at(3) });
@@ -248,13 +395,16 @@ Color JSONDeserializer::get_color(const Pointer& pointer)
 
 std::size_t JSONDeserializer::get_size_t(const Pointer& pointer)
 {
-  return get_t<std::size_t>(m_store, pointer);
+  return get_t<std::size_t>(at(pointer), pointer);
 }
 
 Vec2f JSONDeserializer::get_vec2f(const Pointer& pointer)
 {
   try {
-    return Vec2f(get_t<std::vector<double>>(m_store, pointer));
+    if (const Record* record = this->record(pointer); record != nullptr && record->numbers) {
+      return Vec2f(*record->numbers);
+    }
+    return Vec2f(get_t<std::vector<double>>(at(pointer), pointer));
   } catch (std::out_of_range&) {
     throw omm::AbstractDeserializer::DeserializeError("Expected vector of size 2.");
   }
@@ -263,7 +413,7 @@ Vec2f JSONDeserializer::get_vec2f(const Pointer& pointer)
 Vec2i JSONDeserializer::get_vec2i(const Pointer& pointer)
 {
   try {
-    return Vec2i(get_t<std::vector<int>>(m_store, pointer));
+    return Vec2i(get_t<std::vector<int>>(at(pointer), pointer));
   } catch (std::out_of_range&) {
     throw omm::AbstractDeserializer::DeserializeError("Expected vector of size 2.");
   }
@@ -285,8 +435,10 @@ JSONDeserializer::get_trigger_dummy_value(const AbstractDeserializer::Pointer& p
 SplineType JSONDeserializer::get_spline(const AbstractDeserializer::Pointer& pointer)
 {
   SplineType::knot_map_type map;
-  for (const auto& item : m_store[ptr(pointer)]) {
-    map.insert({ item.at(0), SplineType::Knot(item.at(1), item.at(2), item.at(3) )});
+  if (const nlohmann::json* array = find(pointer); array != nullptr) {
+    for (const auto& item : *array) {
+      map.insert({ item.at(0), SplineType::Knot(item.at(1), item.at(2), item.at(3) )});
+    }
   }
 
   return SplineType(map);
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <optional>
+#include <vector>
+#include <QHash>
 #include "serializers/abstractserializer.h"
 #include "external/json.hpp"
 #include "color/color.h"
@@ -51,8 +54,49 @@ public:
   TriggerPropertyDummyValueType get_trigger_dummy_value(const Pointer& pointer) override;
   SplineType get_spline(const Pointer& pointer) override;
 
+  /**
+   * @brief decode converts the subtrees at @code pointers into records on worker threads, one
+   *  subtree per task. The workers only read the document, hence no locking is required.
+   *  Reading a value below these pointers afterwards looks up its record instead of descending
+   *  the document and converting the value.
+   */
+  void decode(const std::vector<Pointer>& pointers) override;
+
 private:
   nlohmann::json m_store;
+
+  struct Record
+  {
+    const nlohmann::json* node;
+
+    // the converted value if the node is a string or an array of numbers, respectively.
+    std::optional<QString> string;
+    std::optional<std::vector<double>> numbers;
+  };
+  using Records = QHash<Pointer, Record>;
+  Records m_records;
+  static void decode(const nlohmann::json& node, const Pointer& pointer, Records& records);
+  const Record* record(const Pointer& pointer) const;
+
+  /**
+   * @brief The cursor is the path to the most recently resolved node.
+   *  m_cursor[i].node is the node after the first i tokens, m_cursor[0] is the document.
+   *  A pointer is resolved relative to the deepest node it shares with the cursor, hence
+   *  reading the document in order does not descend from the root for each value.
+   */
+  struct Level
+  {
+    QString token;
+    const nlohmann::json* node;
+  };
+  std::vector<Level> m_cursor;
+
+  /**
+   * @brief find returns the node at @code pointer or nullptr if it does not exist.
+   *  It moves the cursor to @code pointer.
+   */
+  const nlohmann::json* find(const Pointer& pointer);
+  const nlohmann::json& at(const Pointer& pointer);
 };
 
 }  // namespace omm
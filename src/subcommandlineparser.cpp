@@ -81,6 +81,19 @@ static const std::map<QString, QList<QCommandLineOption>> options {
         QObject::tr("#FRAMES"),
         "1"
       },
+      {
+        { "j", "jobs" },
+        QObject::tr("number of threads which encode and save the images (optional). "
+                    "Defaults to the number of cores. They are shared among all processes."),
+        QObject::tr("N"),
+      },
+      {
+        { "P", "processes" },
+        QObject::tr("number of processes (optional). "
+                    "Each process loads the scene and renders a contiguous part of the sequence."),
+        QObject::tr("N"),
+        "1"
+      },
       {
         { "G", "no-opengl" },
         QObject::tr("disable OpenGL. OpenGL is enabled by default when using the `%1'-command.")
@@ -95,6 +108,23 @@ static const std::map<QString, QList<QCommandLineOption>> options {
       make_verbosity_option(),
     }
   },
+  {
+    omm::SubcommandLineParser::COMMAND_CONVERT,
+    {
+      make_input_option(),
+      make_verbosity_option(),
+      {
+        { "o", "output" },
+        QObject::tr("Where to save the converted scene. "
+                    "The format is determined by the suffix (.omm: JSON, .ommb: binary)."),
+        QObject::tr("FILENAME")
+      },
+      {
+        { "y", "overwrite" },
+        QObject::tr("Overwrite existing files without warning.")
+      },
+    }
+  },
 };
 
 namespace omm
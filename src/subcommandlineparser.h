@@ -12,6 +12,7 @@ class SubcommandLineParser : public QCommandLineParser
 public:
   static constexpr auto COMMAND_TREE = "tree";
   static constexpr auto COMMAND_RENDER = "render";
+  static constexpr auto COMMAND_CONVERT = "convert";
   explicit SubcommandLineParser(int argc, char* argv[]);
   explicit SubcommandLineParser();
   QString command() const { return m_command; }
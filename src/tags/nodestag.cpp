@@ -68,6 +68,7 @@ NodesTag::NodesTag(const NodesTag& other)
 
 NodesTag::~NodesTag()
 {
+  Application::instance().python_engine.invalidate_cache(this);
 }
 
 QString NodesTag::type() const { return TYPE; }
@@ -160,4 +161,13 @@ void NodesTag::evaluate()
   }
 }
 
+Tag::FrameEffect NodesTag::frame_effect() const
+{
+  if (property(UPDATE_MODE_PROPERTY_KEY)->value<std::size_t>() == 1) {
+    return FrameEffect::Arbitrary;
+  } else {
+    return FrameEffect::None;
+  }
+}
+
 }  // namespace omm
@@ -29,6 +29,7 @@ public:
   void on_property_value_changed(Property* property) override;
   void evaluate() override;
   void force_evaluate() override;
+  FrameEffect frame_effect() const override;
   Flag flags() const override;
   std::set<Node*> nodes() const;
 
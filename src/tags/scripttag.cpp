@@ -42,6 +42,13 @@ ScriptTag::ScriptTag(Object& owner)
     .set_category(QObject::tr("script"));
 }
 
+ScriptTag::~ScriptTag()
+{
+  if (Scene* scene = owner->scene(); scene != nullptr) {
+    scene->python_engine.invalidate_cache(this);
+  }
+}
+
 QString ScriptTag::type() const { return TYPE; }
 Flag ScriptTag::flags() const { return Tag::flags() | Flag::HasScript; }
 
@@ -49,6 +56,8 @@ void ScriptTag::on_property_value_changed(Property *property)
 {
   if (property == this->property(TRIGGER_UPDATE_PROPERTY_KEY)) {
     force_evaluate();
+  } else if (property == this->property(CODE_PROPERTY_KEY)) {
+    owner->scene()->python_engine.invalidate_cache(this);
   }
 }
 
@@ -57,7 +66,8 @@ void ScriptTag::force_evaluate()
   Scene* scene = owner->scene();
   assert(scene != nullptr);
   using namespace py::literals;
-  const auto code = property(ScriptTag::CODE_PROPERTY_KEY)->value<QString>();
+  const auto code = scene->python_engine.compile(property(CODE_PROPERTY_KEY)->value<QString>(),
+                                                 this);
   auto locals = py::dict( "this"_a=TagWrapper::make(*this),
                           "scene"_a=SceneWrapper(*scene) );
   scene->python_engine.exec(code, locals, this);
@@ -71,4 +81,13 @@ void ScriptTag::evaluate()
   }
 }
 
+Tag::FrameEffect ScriptTag::frame_effect() const
+{
+  if (property(UPDATE_MODE_PROPERTY_KEY)->value<std::size_t>() == 1) {
+    return FrameEffect::Arbitrary;
+  } else {
+    return FrameEffect::None;
+  }
+}
+
 }  // namespace omm
@@ -9,6 +9,7 @@ class ScriptTag : public Tag
 {
 public:
   explicit ScriptTag(Object& owner);
+  ~ScriptTag();
   QString type() const override;
   static constexpr auto TYPE = QT_TRANSLATE_NOOP("any-context", "ScriptTag");
   static constexpr auto CODE_PROPERTY_KEY = "code";
@@ -17,6 +18,7 @@ public:
   void on_property_value_changed(Property* property) override;
   void evaluate() override;
   void force_evaluate() override;
+  FrameEffect frame_effect() const override;
   Flag flags() const override;
 };
 
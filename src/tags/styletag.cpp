@@ -32,6 +32,7 @@ Flag StyleTag::flags() const { return Tag::flags(); }
 void StyleTag::on_property_value_changed(Property *property)
 {
   if (property == this->property(STYLE_REFERENCE_PROPERTY_KEY)) {
+    owner->styles.invalidate();
     owner->scene()->message_box().appearance_changed(*owner);
   } else if (property == this->property(EDIT_STYLE_PROPERTY_KEY)) {
     auto* style = this->property(STYLE_REFERENCE_PROPERTY_KEY)->value<AbstractPropertyOwner*>();
@@ -15,6 +15,7 @@ public:
   static constexpr auto TYPE = QT_TRANSLATE_NOOP("any-context", "StyleTag");
   static constexpr auto EDIT_STYLE_PROPERTY_KEY = "edit-style";
   void evaluate() override;
+  FrameEffect frame_effect() const override { return FrameEffect::None; }
   Flag flags() const override;
 
 protected:
@@ -24,6 +24,15 @@ public:
   Object* owner;
   virtual void evaluate() = 0;
   virtual void force_evaluate() { evaluate(); }
+
+  /**
+   * @brief The FrameEffect enum describes what `evaluate` does to the scene.
+   *  None: nothing. Properties: it only writes property values.
+   *  Arbitrary: it may change the scene in ways which are not observable as property writes,
+   *  e.g., by running python code.
+   */
+  enum class FrameEffect { None, Properties, Arbitrary };
+  virtual FrameEffect frame_effect() const { return FrameEffect::Properties; }
   Flag flags() const override;
 };
 
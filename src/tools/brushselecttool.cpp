@@ -75,10 +75,12 @@ void BrushSelectTool
   for (Object* object : scene()->item_selection<Object>()) {
     Path* path = type_cast<Path*>(object);
     if (path) {
-      for (auto&& point : *path) {
-        // we can't transform `pos` with path's inverse transformation because if it scales,
-        // `radius` will be wrong.
-        const auto gt = path->global_transformation(Space::Viewport);
+      // we can't transform `pos` with path's inverse transformation because if it scales,
+      // `radius` will be wrong.
+      const auto gt = path->global_transformation(Space::Viewport);
+      const auto local_region = gt.inverted().apply(BoundingBox(pos, radius));
+      for (const auto& [segment, i] : path->point_index().query(local_region)) {
+        Point& point = path->segments[segment][i];
         const auto gpos = gt.apply_to_position(point.position);
         if ((gpos - pos).euclidean_norm() < radius) {
           if (point.is_selected != extend_selection) {
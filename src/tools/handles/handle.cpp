@@ -49,6 +49,7 @@ void Handle::mouse_release(const Vec2f& pos, const QMouseEvent&)
 }
 
 HandleStatus Handle::status() const { return m_status; }
+bool Handle::is_engaged() const { return m_status != HandleStatus::Inactive; }
 void Handle::deactivate() { m_status = HandleStatus::Inactive; }
 
 double Handle::draw_epsilon() const { return 4.0; }
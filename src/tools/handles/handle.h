@@ -24,7 +24,12 @@ public:
   virtual bool mouse_press(const Vec2f& pos, const QMouseEvent& event);
   virtual bool mouse_move(const Vec2f& delta, const Vec2f& pos, const QMouseEvent&);
   virtual void mouse_release(const Vec2f& pos, const QMouseEvent&);
-  HandleStatus status() const;
+  virtual HandleStatus status() const;
+
+  /**
+   * @brief is_engaged returns whether this handle or any of its sub-handles is not inactive.
+   */
+  virtual bool is_engaged() const;
   virtual void deactivate();
   virtual double draw_epsilon() const;
   virtual double interact_epsilon() const;
@@ -214,6 +214,13 @@ transform_tangent(const Vec2f& delta, TangentMode mode, TangentHandle::Tangent t
   tool.scene()->submit<ModifyPointsCommand>(map);
 }
 
+bool PointSelectHandle::is_engaged() const
+{
+  return AbstractSelectHandle::is_engaged()
+      || m_left_tangent_handle->is_engaged()
+      || m_right_tangent_handle->is_engaged();
+}
+
 bool PointSelectHandle::tangents_active() const
 {
   const auto& imode_property = m_iterator.path->property(Path::INTERPOLATION_PROPERTY_KEY);
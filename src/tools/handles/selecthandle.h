@@ -56,6 +56,7 @@ public:
   void mouse_release( const Vec2f& pos, const QMouseEvent& event) override;
 
   void transform_tangent(const Vec2f& delta, TangentHandle::Tangent tangent);
+  bool is_engaged() const override;
   bool force_draw_subhandles = false;
 
 protected:
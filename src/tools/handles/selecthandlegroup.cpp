@@ -0,0 +1,79 @@
+#include "tools/handles/selecthandlegroup.h"
+#include "objects/path.h"
+#include "scene/objecttree.h"
+#include "scene/scene.h"
+#include "scene/spatialindex.h"
+
+namespace omm
+{
+
+ObjectSelectHandleGroup::ObjectSelectHandleGroup(Tool& tool, Scene& scene,
+                                                 const std::vector<Object*>& objects)
+  : SelectHandleGroup(tool)
+  , m_scene(scene)
+{
+  m_handles.reserve(objects.size());
+  for (Object* object : objects) {
+    m_indices.insert({ object, m_handles.size() });
+    m_handles.push_back(std::make_unique<ObjectSelectHandle>(tool, scene, *object));
+  }
+}
+
+std::set<std::size_t> ObjectSelectHandleGroup::candidates(const Vec2f& pos) const
+{
+  // The handles are drawn in viewport space, i.e., in the space of the root object.
+  const auto& viewport_transformation = m_scene.object_tree().root().transformation();
+  const BoundingBox region(pos, interact_epsilon());
+  const auto scene_region = viewport_transformation.inverted().apply(region);
+
+  std::set<std::size_t> candidates;
+  for (Object* object : m_scene.spatial_index().objects(scene_region)) {
+    if (const auto it = m_indices.find(object); it != m_indices.end()) {
+      candidates.insert(it->second);
+    }
+  }
+  return candidates;
+}
+
+PointSelectHandleGroup::PointSelectHandleGroup(Tool& tool, const std::set<Path*>& paths,
+                                               bool force_draw_subhandles)
+  : SelectHandleGroup(tool)
+{
+  for (Path* path : paths) {
+    PathHandles path_handles { path, {} };
+    path_handles.segment_offsets.reserve(path->segments.size());
+    std::size_t offset = m_handles.size();
+    for (const auto& segment : path->segments) {
+      path_handles.segment_offsets.push_back(offset);
+      offset += segment.size();
+    }
+    m_paths.push_back(std::move(path_handles));
+    m_handles.reserve(m_handles.size() + path->count());
+    for (auto it = path->begin(); it != path->end(); ++it) {
+      auto handle = std::make_unique<PointSelectHandle>(tool, it);
+      handle->force_draw_subhandles = force_draw_subhandles;
+      m_handles.push_back(std::move(handle));
+    }
+  }
+}
+
+std::set<std::size_t> PointSelectHandleGroup::candidates(const Vec2f& pos) const
+{
+  const BoundingBox region(pos, interact_epsilon());
+  std::set<std::size_t> candidates;
+  for (const PathHandles& path_handles : m_paths) {
+    const Path& path = *path_handles.path;
+    const auto local_region = path.global_transformation(Space::Viewport).inverted().apply(region);
+    for (const auto& [segment, point] : path.point_index().query(local_region)) {
+      // the tool resets its handles when points are added or removed. Until then, ignore them.
+      if (segment < path_handles.segment_offsets.size()) {
+        if (const std::size_t i = path_handles.segment_offsets[segment] + point; i < m_handles.size()) {
+          candidates.insert(i);
+        }
+      }
+    }
+  }
+  return candidates;
+}
+
+}  // namespace omm
@@ -0,0 +1,179 @@
+#pragma once
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <set>
+#include <vector>
+#include <QPainter>
+#include "tools/handles/selecthandle.h"
+
+namespace omm
+{
+
+class Scene;
+class Path;
+
+/**
+ * @brief The SelectHandleGroup class dispatches the mouse events to many select handles.
+ *  Instead of testing each handle, it asks `candidates` for the handles near the mouse.
+ *  The handles are processed in reverse order, like `Tool` processes its handles.
+ */
+template<typename HandleT> class SelectHandleGroup : public Handle
+{
+public:
+  explicit SelectHandleGroup(Tool& tool) : Handle(tool) {}
+
+  void draw(QPainter& painter) const override
+  {
+    for (auto&& handle : m_handles) {
+      painter.save();
+      handle->draw(painter);
+      painter.restore();
+    }
+  }
+
+  bool mouse_press(const Vec2f& pos, const QMouseEvent& event) override
+  {
+    const auto indices = relevant_handles(pos);
+    for (auto it = indices.rbegin(); it != indices.rend(); ++it) {
+      const bool hit = m_handles[*it]->mouse_press(pos, event);
+      update_engagement(*it);
+      if (hit) {
+        m_is_dragging = true;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool mouse_move(const Vec2f& delta, const Vec2f& pos, const QMouseEvent& event) override
+  {
+    // while a handle is dragged, the index is likely outdated and there is no need to query it.
+    const auto indices = m_is_dragging ? m_engaged_handles : relevant_handles(pos);
+    for (auto it = indices.rbegin(); it != indices.rend(); ++it) {
+      m_handles[*it]->mouse_move(delta, pos, event);
+      update_engagement(*it);
+      if (m_handles[*it]->status() == HandleStatus::Active) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void mouse_release(const Vec2f& pos, const QMouseEvent& event) override
+  {
+    for (const std::size_t i : relevant_handles(pos)) {
+      m_handles[i]->mouse_release(pos, event);
+    }
+    m_engaged_handles.clear();
+    m_is_dragging = false;
+  }
+
+  HandleStatus status() const override
+  {
+    HandleStatus status = HandleStatus::Inactive;
+    for (const std::size_t i : m_engaged_handles) {
+      switch (m_handles[i]->status()) {
+      case HandleStatus::Active:
+        return HandleStatus::Active;
+      case HandleStatus::Hovered:
+        status = HandleStatus::Hovered;
+        break;
+      case HandleStatus::Inactive:
+        break;
+      }
+    }
+    return status;
+  }
+
+  void deactivate() override
+  {
+    for (const std::size_t i : m_engaged_handles) {
+      m_handles[i]->deactivate();
+    }
+    m_engaged_handles.clear();
+    m_is_dragging = false;
+  }
+
+protected:
+  bool contains_global(const Vec2f& point) const override
+  {
+    const auto indices = candidates(point);
+    return std::any_of(indices.begin(), indices.end(), [this, point](const std::size_t i) {
+      return m_handles[i]->contains_global(point);
+    });
+  }
+
+  /**
+   * @brief candidates returns the indices of all handles which might contain @code pos.
+   *  It may return handles which do not contain @code pos but it must not miss any.
+   */
+  virtual std::set<std::size_t> candidates(const Vec2f& pos) const = 0;
+  std::vector<std::unique_ptr<HandleT>> m_handles;
+
+private:
+  // handles which are engaged must receive events even if they are no candidates.
+  std::set<std::size_t> m_engaged_handles;
+  bool m_is_dragging = false;
+
+  std::set<std::size_t> relevant_handles(const Vec2f& pos) const
+  {
+    auto indices = candidates(pos);
+    indices.insert(m_engaged_handles.begin(), m_engaged_handles.end());
+    return indices;
+  }
+
+  void update_engagement(const std::size_t i)
+  {
+    if (m_handles[i]->is_engaged()) {
+      m_engaged_handles.insert(i);
+    } else {
+      m_engaged_handles.erase(i);
+    }
+  }
+};
+
+/**
+ * @brief The ObjectSelectHandleGroup class holds an `ObjectSelectHandle` for each given object.
+ *  The candidates are found with `Scene::spatial_index`.
+ */
+class ObjectSelectHandleGroup : public SelectHandleGroup<ObjectSelectHandle>
+{
+public:
+  explicit ObjectSelectHandleGroup(Tool& tool, Scene& scene, const std::vector<Object*>& objects);
+
+protected:
+  std::set<std::size_t> candidates(const Vec2f& pos) const override;
+
+private:
+  Scene& m_scene;
+  std::map<const Object*, std::size_t> m_indices;
+};
+
+/**
+ * @brief The PointSelectHandleGroup class holds a `PointSelectHandle` for each point of the given
+ *  paths. The candidates are found with `Path::point_index`.
+ */
+class PointSelectHandleGroup : public SelectHandleGroup<PointSelectHandle>
+{
+public:
+  explicit PointSelectHandleGroup(Tool& tool, const std::set<Path*>& paths,
+                                  bool force_draw_subhandles);
+
+protected:
+  std::set<std::size_t> candidates(const Vec2f& pos) const override;
+
+private:
+  struct PathHandles
+  {
+    Path* path;
+
+    // the index of the first handle of each segment of `path`.
+    std::vector<std::size_t> segment_offsets;
+  };
+
+  std::vector<PathHandles> m_paths;
+};
+
+}  // namespace omm
@@ -8,6 +8,7 @@
 #include "scene/scene.h"
 #include "properties/optionproperty.h"
 #include "tools/handles/boundingboxhandle.h"
+#include "tools/handles/selecthandlegroup.h"
 
 namespace omm
 {
@@ -52,11 +53,8 @@ void SelectObjectsTool::reset()
     return object->is_visible(true);
   });
 
-  handles.reserve(objects.size());
-  auto inserter = std::back_inserter(handles);
-  std::transform(objects.begin(), objects.end(), inserter, [this](Object* o) {
-    return std::make_unique<ObjectSelectHandle>(*this, *scene(), *o);
-  });
+  const std::vector<Object*> ordered_objects(objects.begin(), objects.end());
+  handles.push_back(std::make_unique<ObjectSelectHandleGroup>(*this, *scene(), ordered_objects));
   handles.push_back(std::make_unique<MoveParticleHandle<tool_t>>(*this));
 }
 
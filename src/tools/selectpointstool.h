@@ -7,6 +7,7 @@
 #include "tools/handles/scalebandhandle.h"
 #include "tools/handles/particlehandle.h"
 #include "commands/pointstransformationcommand.h"
+#include "tools/handles/selecthandlegroup.h"
 
 namespace omm
 {
@@ -56,14 +57,8 @@ public:
 
     tool.handles.push_back(std::make_unique<MoveParticleHandle<ToolT>>(tool));
 
-    for (auto* path : type_cast<Path*>(tool.scene()->template item_selection<Object>())) {
-      tool.handles.reserve(tool.handles.size() + path->count());
-      for (auto it = path->begin(); it != path->end(); ++it) {
-        auto handle = std::make_unique<PointSelectHandle>(tool, it);
-        handle->force_draw_subhandles = force_subhandles;
-        tool.handles.push_back(std::move(handle));
-      }
-    }
+    const auto paths = type_cast<Path*>(tool.scene()->template item_selection<Object>());
+    tool.handles.push_back(std::make_unique<PointSelectHandleGroup>(tool, paths, force_subhandles));
   }
 
   BoundingBox bounding_box() const;
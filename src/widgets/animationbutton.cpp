@@ -225,7 +225,7 @@ std::unique_ptr<QMenu> AnimationButton::make_interpolation_menu() const
             properties.insert(property);
           }
         }
-        m_animator.scene.submit<SetInterpolationCommand>(properties, interpolation);
+        m_animator.scene.submit<SetInterpolationCommand>(m_animator, properties, interpolation);
       });
     } else {
       action->setEnabled(false);
@@ -0,0 +1,74 @@
+#include "gtest/gtest.h"
+#include "geometry/arclengthtable.h"
+#include "2geom/pathvector.h"
+#include "2geom/bezier-curve.h"
+
+namespace
+{
+
+Geom::CubicBezier line(const Geom::Point& a, const Geom::Point& b)
+{
+  // control points at thirds yield a uniform parametrization.
+  return Geom::CubicBezier(a, (2.0 * a + b) / 3.0, (a + 2.0 * b) / 3.0, b);
+}
+
+Geom::PathVector make_paths(const std::vector<Geom::CubicBezier>& curves)
+{
+  Geom::PathVector paths;
+  paths.push_back(Geom::Path(curves.begin(), curves.end(), false));
+  return paths;
+}
+
+}  // namespace
+
+TEST(ArcLengthTableTest, empty)
+{
+  const omm::ArcLengthTable table;
+  EXPECT_DOUBLE_EQ(table.length(), 0.0);
+  const auto t = table.time(0.5);
+  EXPECT_EQ(t.path_index, 0u);
+  EXPECT_EQ(t.curve_index, 0u);
+}
+
+TEST(ArcLengthTableTest, polyline)
+{
+  const auto paths = make_paths({ line({0, 0}, {100, 0}), line({100, 0}, {100, 300}) });
+  const omm::ArcLengthTable table(paths);
+  EXPECT_NEAR(table.length(), 400.0, 1e-6);
+
+  const auto t1 = table.time(0.125);
+  EXPECT_EQ(t1.curve_index, 0u);
+  EXPECT_NEAR(t1.t, 0.5, 1e-6);
+
+  const auto t2 = table.time(0.625);
+  EXPECT_EQ(t2.curve_index, 1u);
+  EXPECT_NEAR(t2.t, 0.5, 1e-6);
+
+  const auto t3 = table.time(0, 1.0);
+  EXPECT_EQ(t3.curve_index, 1u);
+  EXPECT_NEAR(t3.t, 1.0, 1e-6);
+}
+
+TEST(ArcLengthTableTest, multiple_paths)
+{
+  Geom::PathVector paths = make_paths({ line({0, 0}, {100, 0}) });
+  paths.push_back(make_paths({ line({0, 100}, {300, 100}) }).front());
+  const omm::ArcLengthTable table(paths);
+  EXPECT_NEAR(table.length(0), 100.0, 1e-6);
+  EXPECT_NEAR(table.length(1), 300.0, 1e-6);
+
+  const auto t = table.time(0.5);
+  EXPECT_EQ(t.path_index, 1u);
+  EXPECT_NEAR(t.t, 1.0 / 3.0, 1e-6);
+}
+
+TEST(ArcLengthTableTest, non_uniform_parametrization)
+{
+  // the curve is a straight line, but its speed is not uniform.
+  const Geom::CubicBezier curve({0, 0}, {0, 0}, {10, 0}, {100, 0});
+  const omm::ArcLengthTable table(make_paths({ curve }));
+  for (const double d : { 0.1, 0.3, 0.5, 0.7, 0.9 }) {
+    const auto t = table.time(d);
+    EXPECT_NEAR(curve.pointAt(t.t).x(), 100.0 * d, 0.5);
+  }
+}
@@ -0,0 +1,148 @@
+#include "gtest/gtest.h"
+#include "aspects/propertyowner.h"
+#include "properties/colorproperty.h"
+#include "properties/splineproperty.h"
+#include "serializers/binaryserializer.h"
+#include "serializers/jsonserializer.h"
+#include <limits>
+#include <sstream>
+
+namespace
+{
+
+using omm::PolarCoordinates;
+const std::vector<omm::Point> points {
+  omm::Point(omm::Vec2f(1.0, 2.0), PolarCoordinates(0.5, 3.0), PolarCoordinates(-0.5, 4.0)),
+  omm::Point(omm::Vec2f(-1.5, 0.25), PolarCoordinates(1.0, 0.0), PolarCoordinates(2.0, 1.0)),
+};
+
+std::string serialize()
+{
+  std::ostringstream ostream;
+  {
+    omm::BinarySerializer serializer(ostream);
+    serializer.set_value(true, "/bool");
+    serializer.set_value(-42, "/int");
+    serializer.set_value(std::numeric_limits<double>::infinity(), "/double");
+    serializer.set_value(QString("äöü"), "/string");
+    serializer.set_value(std::size_t(123456789012), "/size_t");
+    serializer.set_value(omm::Vec2f(0.5, -0.25), "/vec2f");
+    serializer.set_value(omm::Vec2i(3, -4), "/vec2i");
+    serializer.start_array(2, "/array");
+    serializer.end_array();
+    serializer.set_points(points, "/points");
+  }
+  return ostream.str();
+}
+
+/**
+ * @brief The Owner class stands in for the objects of a scene. It has the record types which the
+ *  binary format stores differently from JSON: colors, splines and polar coordinates.
+ */
+class Owner : public omm::PropertyOwner<omm::Kind::None>
+{
+public:
+  Owner() : PropertyOwner(nullptr)
+  {
+    create_property<omm::ColorProperty>(COLOR_KEY, omm::Color());
+    create_property<omm::SplineProperty>(SPLINE_KEY);
+  }
+
+  QString type() const override { return "Owner"; }
+  omm::Flag flags() const override { return omm::Flag::None; }
+  omm::PolarCoordinates tangent;
+
+  void serialize(omm::AbstractSerializer& serializer, const Pointer& root) const override
+  {
+    PropertyOwner::serialize(serializer, root);
+    serializer.set_value(tangent, make_pointer(root, "tangent"));
+  }
+
+  void deserialize(omm::AbstractDeserializer& deserializer, const Pointer& root) override
+  {
+    PropertyOwner::deserialize(deserializer, root);
+    tangent = deserializer.get_polarcoordinates(make_pointer(root, "tangent"));
+  }
+
+  static constexpr auto COLOR_KEY = "color";
+  static constexpr auto SPLINE_KEY = "spline";
+};
+
+template<typename SerializerT, typename DeserializerT> void copy(const Owner& source, Owner& target)
+{
+  std::stringstream stream;
+  {
+    SerializerT serializer(stream);
+    source.serialize(serializer, "/owner");
+  }
+  DeserializerT deserializer(stream);
+  target.deserialize(deserializer, "/owner");
+}
+
+}  // namespace
+
+TEST(BinarySerializer, round_trip)
+{
+  std::istringstream istream(serialize());
+  omm::BinaryDeserializer deserializer(istream);
+  EXPECT_TRUE(deserializer.get_bool("/bool"));
+  EXPECT_EQ(deserializer.get_int("/int"), -42);
+  EXPECT_EQ(deserializer.get_double("/double"), std::numeric_limits<double>::infinity());
+  EXPECT_EQ(deserializer.get_string("/string"), QString("äöü"));
+  EXPECT_EQ(deserializer.get_size_t("/size_t"), 123456789012u);
+  EXPECT_EQ(deserializer.get_vec2f("/vec2f"), omm::Vec2f(0.5, -0.25));
+  EXPECT_EQ(deserializer.get_vec2i("/vec2i"), omm::Vec2i(3, -4));
+  EXPECT_EQ(deserializer.array_size("/array"), 2u);
+  EXPECT_EQ(deserializer.array_size("/missing"), 0u);
+
+  const auto actual_points = deserializer.get_points("/points");
+  ASSERT_EQ(actual_points.size(), points.size());
+  EXPECT_EQ(deserializer.array_size("/points"), points.size());
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    EXPECT_EQ(actual_points[i].position, points[i].position);
+    EXPECT_EQ(actual_points[i].left_tangent, points[i].left_tangent);
+    EXPECT_EQ(actual_points[i].right_tangent, points[i].right_tangent);
+  }
+}
+
+TEST(BinarySerializer, errors)
+{
+  std::istringstream garbage("{ \"not\": \"binary\" }");
+  EXPECT_THROW(omm::BinaryDeserializer{garbage}, omm::AbstractDeserializer::DeserializeError);
+
+  std::string data = serialize();
+  std::istringstream truncated(data.substr(0, data.size() / 2));
+  EXPECT_THROW(omm::BinaryDeserializer{truncated}, omm::AbstractDeserializer::DeserializeError);
+
+  std::istringstream istream(data);
+  omm::BinaryDeserializer deserializer(istream);
+  EXPECT_THROW(deserializer.get_string("/int"), omm::AbstractDeserializer::DeserializeError);
+  EXPECT_THROW(deserializer.get_int("/missing"), omm::AbstractDeserializer::DeserializeError);
+  EXPECT_EQ(deserializer.get_double("/int"), -42.0);
+}
+
+TEST(BinarySerializer, json_round_trip)
+{
+  Owner original;
+  original.property(Owner::COLOR_KEY)->set(omm::Color(omm::Color::Model::RGBA,
+                                                      { 0.25, 0.5, 0.75, 0.5 }));
+  omm::SplineType spline(omm::SplineType::Initialization::Ease, false);
+  original.property(Owner::SPLINE_KEY)->set(spline);
+  original.tangent = PolarCoordinates(0.5, 2.0);
+
+  // JSON -> binary -> JSON, as when a scene is converted back and forth.
+  Owner from_json;
+  Owner from_binary;
+  Owner result;
+  copy<omm::JSONSerializer, omm::JSONDeserializer>(original, from_json);
+  copy<omm::BinarySerializer, omm::BinaryDeserializer>(from_json, from_binary);
+  copy<omm::JSONSerializer, omm::JSONDeserializer>(from_binary, result);
+
+  for (const Owner* owner : { &from_binary, &result }) {
+    EXPECT_EQ(owner->id(), original.id());
+    EXPECT_EQ(owner->property(Owner::COLOR_KEY)->value<omm::Color>(),
+              original.property(Owner::COLOR_KEY)->value<omm::Color>());
+    EXPECT_EQ(owner->property(Owner::SPLINE_KEY)->value<omm::SplineType>(), spline);
+    EXPECT_EQ(owner->tangent, original.tangent);
+  }
+}
@@ -0,0 +1,105 @@
+#include "gtest/gtest.h"
+#include "geometry/boundingvolumehierarchy.h"
+#include <algorithm>
+#include <random>
+
+namespace
+{
+
+using BVH = omm::BoundingVolumeHierarchy<std::size_t>;
+
+std::vector<std::size_t> brute_force(const std::vector<BVH::Item>& items,
+                                     const omm::BoundingBox& region)
+{
+  std::vector<std::size_t> values;
+  for (const auto& item : items) {
+    if (item.bounding_box.intersects(region)) {
+      values.push_back(item.value);
+    }
+  }
+  return values;
+}
+
+std::vector<std::size_t> sorted(std::vector<std::size_t> values)
+{
+  std::sort(values.begin(), values.end());
+  return values;
+}
+
+}  // namespace
+
+TEST(BoundingVolumeHierarchyTest, empty)
+{
+  const BVH bvh;
+  EXPECT_EQ(bvh.size(), 0u);
+  EXPECT_TRUE(bvh.query(omm::BoundingBox(omm::Vec2f(0, 0), 100.0)).empty());
+}
+
+TEST(BoundingVolumeHierarchyTest, ignore_empty_boxes)
+{
+  const BVH bvh({ { omm::BoundingBox(), 0 }, { omm::BoundingBox(omm::Vec2f(0, 0), 1.0), 1 } });
+  EXPECT_EQ(bvh.size(), 1u);
+  EXPECT_EQ(bvh.query(omm::BoundingBox(omm::Vec2f(0, 0), 100.0)), std::vector<std::size_t>{ 1 });
+}
+
+TEST(BoundingVolumeHierarchyTest, points)
+{
+  std::vector<BVH::Item> items;
+  for (std::size_t i = 0; i < 100; ++i) {
+    const omm::Vec2f p(static_cast<double>(i), 0.0);
+    items.push_back({ omm::BoundingBox(p, p), i });
+  }
+  const BVH bvh(items);
+  EXPECT_EQ(sorted(bvh.query(omm::BoundingBox(omm::Vec2f(50, 0), 2.0))),
+            (std::vector<std::size_t>{ 48, 49, 50, 51, 52 }));
+  EXPECT_TRUE(bvh.query(omm::BoundingBox(omm::Vec2f(50, 10), 2.0)).empty());
+}
+
+TEST(BoundingVolumeHierarchyTest, random)
+{
+  std::mt19937 rng;
+  rng.seed(42);
+  std::uniform_real_distribution<> position(-1000, 1000);
+  std::uniform_real_distribution<> radius(0, 50);
+
+  std::vector<BVH::Item> items;
+  for (std::size_t i = 0; i < 10000; ++i) {
+    items.push_back({ omm::BoundingBox(omm::Vec2f(position(rng), position(rng)), radius(rng)), i });
+  }
+  const BVH bvh(items);
+
+  for (std::size_t i = 0; i < 100; ++i) {
+    const omm::BoundingBox region(omm::Vec2f(position(rng), position(rng)), radius(rng));
+    EXPECT_EQ(sorted(bvh.query(region)), sorted(brute_force(items, region)));
+  }
+}
+
+TEST(BoundingVolumeHierarchyTest, update)
+{
+  std::mt19937 rng;
+  rng.seed(42);
+  std::uniform_real_distribution<> position(-1000, 1000);
+  std::uniform_real_distribution<> radius(0, 50);
+  const auto random_box = [&]() {
+    return omm::BoundingBox(omm::Vec2f(position(rng), position(rng)), radius(rng));
+  };
+
+  std::vector<BVH::Item> items;
+  for (std::size_t i = 0; i < 1000; ++i) {
+    items.push_back({ random_box(), i });
+  }
+  BVH bvh(items);
+
+  for (std::size_t i = 0; i < 100; ++i) {
+    const std::size_t index = i * 7 % items.size();
+    items[index].bounding_box = random_box();
+    ASSERT_TRUE(bvh.update(index, items[index].bounding_box));
+  }
+  for (std::size_t i = 0; i < 100; ++i) {
+    const omm::BoundingBox region = random_box();
+    EXPECT_EQ(sorted(bvh.query(region)), sorted(brute_force(items, region)));
+  }
+
+  EXPECT_FALSE(bvh.update(0, omm::BoundingBox()));
+  EXPECT_FALSE(bvh.update(items.size(), random_box()));
+}
@@ -0,0 +1,123 @@
+#include "gtest/gtest.h"
+#include "mainwindow/exportdialog.h"
+#include <QPainter>
+#include <QPainterPath>
+#include <algorithm>
+
+namespace
+{
+
+using omm::ExportDialog;
+constexpr int TILE_SIZE = ExportDialog::TILE_SIZE;
+constexpr double SCALE = 1.5;
+
+// the size of the whole rendering, it spans three by three tiles.
+const QSize SIZE(2 * TILE_SIZE + 100, 2 * TILE_SIZE + 50);
+
+/**
+ * @brief record returns overlapping, semi-transparent drawings which straddle the borders of the
+ *  tiles (at multiples of `TILE_SIZE / SCALE` in unscaled coordinates).
+ */
+ExportDialog::Recording record()
+{
+  const double border = TILE_SIZE / SCALE;
+  ExportDialog::Recording recording(5);
+  {
+    // the first picture is empty, like the one recorded before the first object.
+    QPainter painter(&recording.at(0));
+  }
+  {
+    QPainter painter(&recording.at(1));
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.setPen(QPen(Qt::black, 3.0));
+    painter.setBrush(QColor(255, 0, 0, 128));
+    painter.drawEllipse(QPointF(border, border), 40.3, 25.7);
+  }
+  {
+    QPainter painter(&recording.at(2));
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.setPen(Qt::NoPen);
+    painter.setBrush(QColor(0, 0, 255, 100));
+    painter.drawRect(QRectF(border - 10.25, 5.5, 20.5, 2.0 * border));
+  }
+  {
+    QPainter painter(&recording.at(3));
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.setPen(QPen(QColor(0, 128, 0, 200), 7.0));
+    painter.drawLine(QPointF(3.0, 2.0 * border - 1.0), QPointF(SIZE.width() / SCALE - 3.0, 7.0));
+  }
+  {
+    QPainter painter(&recording.at(4));
+    painter.setRenderHint(QPainter::Antialiasing);
+    QPainterPath path;
+    path.moveTo(2.0 * border - 30.0, 2.0 * border - 30.0);
+    path.cubicTo(2.0 * border + 50.0, 2.0 * border - 60.0, 2.0 * border - 60.0,
+                 2.0 * border + 50.0, 2.0 * border + 20.0, 2.0 * border + 25.0);
+    painter.setPen(QPen(Qt::darkYellow, 2.5));
+    painter.setBrush(QColor(255, 255, 0, 64));
+    painter.drawPath(path);
+  }
+  return recording;
+}
+
+QImage make_image(const QSize& size)
+{
+  QImage image(size, QImage::Format_ARGB32_Premultiplied);
+  image.fill(Qt::transparent);
+  return image;
+}
+
+/**
+ * @brief render draws @code recording into a single image, without tiles.
+ */
+QImage render(const ExportDialog::Recording& recording)
+{
+  QImage image = make_image(SIZE);
+  QPainter painter(&image);
+  painter.scale(SCALE, SCALE);
+  for (const QPicture& picture : recording) {
+    painter.drawPicture(QPointF(0.0, 0.0), picture);
+  }
+  return image;
+}
+
+}  // namespace
+
+TEST(ExportDialog, replay_tiles)
+{
+  const ExportDialog::Recording recording = record();
+  const QImage expected = render(recording);
+
+  QImage image = make_image(SIZE);
+  ExportDialog::replay(recording, image, QPoint(0, 0), SCALE);
+  EXPECT_EQ(image, expected);
+}
+
+TEST(ExportDialog, replay_bands)
+{
+  // like `ExportDialog::render_png`, but scaled.
+  const ExportDialog::Recording recording = record();
+  const QImage expected = render(recording);
+
+  for (int y = 0; y < SIZE.height(); y += ExportDialog::BAND_HEIGHT) {
+    const QRect rect(0, y, SIZE.width(), std::min(ExportDialog::BAND_HEIGHT, SIZE.height() - y));
+    QImage band = make_image(rect.size());
+    ExportDialog::replay(recording, band, rect.topLeft(), SCALE);
+    EXPECT_EQ(band, expected.copy(rect)) << "y = " << y;
+  }
+}
+
+TEST(ExportDialog, replay_offset)
+{
+  const ExportDialog::Recording recording = record();
+  const QImage expected = render(recording);
+
+  // tiled and untiled (not larger than a tile) rectangles which do not start at a tile border.
+  for (const QRect& rect : { QRect(100, 200, TILE_SIZE + 300, TILE_SIZE + 1),
+                             QRect(TILE_SIZE - 50, TILE_SIZE - 70, TILE_SIZE, 200) })
+  {
+    QImage image = make_image(rect.size());
+    ExportDialog::replay(recording, image, rect.topLeft(), SCALE);
+    EXPECT_EQ(image, expected.copy(rect)) << "x = " << rect.x() << ", y = " << rect.y();
+  }
+}
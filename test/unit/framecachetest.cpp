@@ -0,0 +1,125 @@
+#include "gtest/gtest.h"
+#include "animation/framecache.h"
+#include "animation/track.h"
+#include "properties/floatproperty.h"
+
+namespace
+{
+
+omm::FrameCache::Values make_values(omm::Property& property, double value)
+{
+  return omm::FrameCache::Values{ { &property, value } };
+}
+
+}  // namespace
+
+TEST(FrameCacheTest, disabled)
+{
+  omm::FloatProperty property;
+  omm::FrameCache cache;
+  cache.set_budget(0);
+  cache.insert_values(1, make_values(property, 1.0), false);
+  EXPECT_EQ(cache.values(1), nullptr);
+  EXPECT_EQ(cache.size(), 0u);
+}
+
+TEST(FrameCacheTest, values)
+{
+  omm::FloatProperty property;
+  omm::FrameCache cache;
+  cache.set_budget(omm::FrameCache::MEBIBYTE);
+  cache.insert_values(1, make_values(property, 1.0), false);
+  cache.insert_values(2, make_values(property, 2.0), false);
+  ASSERT_NE(cache.values(1), nullptr);
+  EXPECT_EQ(std::get<double>(cache.values(1)->at(&property)), 1.0);
+  ASSERT_NE(cache.values(2), nullptr);
+  EXPECT_EQ(std::get<double>(cache.values(2)->at(&property)), 2.0);
+  EXPECT_EQ(cache.values(3), nullptr);
+}
+
+TEST(FrameCacheTest, evict_least_recently_used)
+{
+  omm::FloatProperty property;
+  omm::FrameCache cache;
+  cache.set_budget(omm::FrameCache::MEBIBYTE);
+  cache.insert_values(1, make_values(property, 1.0), false);
+  const std::size_t frame_size = cache.size();
+  cache.insert_values(2, make_values(property, 2.0), false);
+  cache.insert_values(3, make_values(property, 3.0), false);
+  ASSERT_EQ(cache.size(), 3 * frame_size);
+
+  cache.values(1);  // frame 2 is the least recently used one now.
+  cache.set_budget(2 * frame_size);
+  EXPECT_NE(cache.values(1), nullptr);
+  EXPECT_EQ(cache.values(2), nullptr);
+  EXPECT_NE(cache.values(3), nullptr);
+  EXPECT_LE(cache.size(), cache.budget());
+}
+
+TEST(FrameCacheTest, invalidate_tag_dependent_frames)
+{
+  omm::FloatProperty property;
+  omm::FrameCache cache;
+  cache.set_budget(omm::FrameCache::MEBIBYTE);
+  cache.insert_values(1, make_values(property, 1.0), true);
+  cache.insert_values(2, make_values(property, 2.0), false);
+  cache.invalidate_tag_dependent_frames();
+  EXPECT_EQ(cache.values(1), nullptr);
+  EXPECT_NE(cache.values(2), nullptr);
+}
+
+TEST(FrameCacheTest, forget_property)
+{
+  omm::FloatProperty property;
+  omm::FloatProperty other_property;
+  omm::FrameCache cache;
+  cache.set_budget(omm::FrameCache::MEBIBYTE);
+  auto values = make_values(property, 1.0);
+  values.insert({ &other_property, 2.0 });
+  cache.insert_values(1, values, false);
+  const std::size_t size = cache.size();
+
+  cache.forget(&property);
+  ASSERT_NE(cache.values(1), nullptr);
+  EXPECT_EQ(cache.values(1)->count(&property), 0u);
+  EXPECT_EQ(cache.values(1)->count(&other_property), 1u);
+  EXPECT_LT(cache.size(), size);
+}
+
+TEST(FrameCacheTest, invalidate_knot)
+{
+  omm::FloatProperty property;
+  omm::Track track(property);
+  for (const int frame : { 10, 20, 30 }) {
+    track.insert_knot(frame, std::make_unique<omm::Track::Knot>(0.0));
+  }
+
+  omm::FrameCache cache;
+  cache.set_budget(omm::FrameCache::MEBIBYTE);
+  const auto fill = [&cache, &property]() {
+    for (int frame = 0; frame <= 40; ++frame) {
+      cache.insert_values(frame, make_values(property, 0.0), false);
+    }
+  };
+  const auto is_cached = [&cache](int frame) { return cache.values(frame) != nullptr; };
+
+  fill();
+  cache.invalidate_frames(track, 20);
+  EXPECT_TRUE(is_cached(10));
+  EXPECT_FALSE(is_cached(11));
+  EXPECT_FALSE(is_cached(20));
+  EXPECT_FALSE(is_cached(29));
+  EXPECT_TRUE(is_cached(30));
+
+  fill();
+  cache.invalidate_frames(track, 10);
+  EXPECT_FALSE(is_cached(0));
+  EXPECT_FALSE(is_cached(19));
+  EXPECT_TRUE(is_cached(20));
+
+  fill();
+  cache.invalidate_frames(track, 30);
+  EXPECT_TRUE(is_cached(20));
+  EXPECT_FALSE(is_cached(21));
+  EXPECT_FALSE(is_cached(40));
+}
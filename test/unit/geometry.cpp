@@ -1,5 +1,7 @@
 #include "gtest/gtest.h"
 #include <random>
+#include <chrono>
+#include <functional>
 #include "geometry/objecttransformation.h"
 #include "logging.h"
 
@@ -176,3 +178,101 @@ TEST(geometry, transform_to_from_mat_random)
     EXPECT_TRUE(fuzzy_equal(t, omm::ObjectTransformation(t.to_mat())));
   }
 }
+
+TEST(geometry, transform_cached_matrix)
+{
+  omm::ObjectTransformation t;
+  t.set_translation({ 2.0, 3.0 });
+  const auto a = t.apply_to_position(omm::Vec2f::o());
+  EXPECT_DOUBLE_EQ(a.x, 2.0);
+  EXPECT_DOUBLE_EQ(a.y, 3.0);
+
+  // modifying a component must invalidate the cached matrix and its inverse.
+  const auto inverse = t.inverted();
+  t.translate({ 1.0, 1.0 });
+  const auto b = t.apply_to_position(omm::Vec2f::o());
+  EXPECT_DOUBLE_EQ(b.x, 3.0);
+  EXPECT_DOUBLE_EQ(b.y, 4.0);
+  const auto c = t.inverted().apply_to_position(b);
+  EXPECT_NEAR(c.x, 0.0, 0.0001);
+  EXPECT_NEAR(c.y, 0.0, 0.0001);
+  EXPECT_TRUE(fuzzy_equal(inverse, omm::ObjectTransformation().translated({ -2.0, -3.0 })));
+}
+
+TEST(geometry, transform_inverse_random)
+{
+  std::mt19937 rng;
+  rng.seed(42);
+  std::uniform_real_distribution<> distribution(-100, 100);
+  std::uniform_real_distribution<> positive_distribution(0.1, 100);
+  constexpr auto n = 1000;
+
+  for (size_t i = 0; i < n; ++i) {
+    omm::ObjectTransformation t;
+    t.set_translation({ distribution(rng), distribution(rng) });
+    t.set_scaling({ positive_distribution(rng), positive_distribution(rng) });
+    t.set_shearing(distribution(rng));
+    t.set_rotation(distribution(rng));
+    EXPECT_TRUE(fuzzy_equal(t.apply(t.inverted()), omm::ObjectTransformation()));
+    EXPECT_TRUE(fuzzy_equal(t, t.inverted().inverted()));
+  }
+}
+
+// Replays the transformation stack of `Painter::push_transformation` for a scene with 10000
+// objects: each push composes the parent's transformation with the object's one and reads the
+// matrix for `QPainter::setTransform`.
+// The baseline rebuilds each composed transformation from its components, which is what `apply`
+// did before the matrix was cached: decompose the product (atan2, sqrt) and recompute the matrix
+// (sin, cos) when it is read.
+// Run with `--gtest_also_run_disabled_tests` to get the timing.
+TEST(geometry, DISABLED_transform_draw_traversal_benchmark)
+{
+  std::mt19937 rng;
+  rng.seed(42);
+  std::uniform_real_distribution<> distribution(-10, 10);
+  constexpr std::size_t n_objects = 10000;
+  constexpr std::size_t n_frames = 100;
+  constexpr std::size_t depth = 10;
+
+  std::vector<omm::ObjectTransformation> transformations;
+  transformations.reserve(n_objects);
+  for (std::size_t i = 0; i < n_objects; ++i) {
+    transformations.emplace_back(omm::Vec2f(distribution(rng), distribution(rng)),
+                                 omm::Vec2f(1.0, 1.0), distribution(rng), 0.0);
+  }
+
+  using Compose = std::function<omm::ObjectTransformation(const omm::ObjectTransformation&,
+                                                          const omm::ObjectTransformation&)>;
+  const auto traverse = [&transformations](const Compose& compose, double& checksum) {
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t frame = 0; frame < n_frames; ++frame) {
+      std::vector<omm::ObjectTransformation> stack;
+      for (std::size_t i = 0; i < n_objects; ++i) {
+        if (stack.size() == depth) {
+          stack.clear();
+        }
+        const auto parent = stack.empty() ? omm::ObjectTransformation() : stack.back();
+        stack.push_back(compose(parent, transformations[i]));
+        checksum += stack.back().to_mat().m[0][0];
+      }
+    }
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count() / n_frames;
+  };
+
+  double cached_checksum = 0.0;
+  const double cached = traverse([](const auto& parent, const auto& t) {
+    return parent.apply(t);
+  }, cached_checksum);
+
+  double baseline_checksum = 0.0;
+  const double baseline = traverse([](const auto& parent, const auto& t) {
+    const auto product = parent.apply(t);
+    return omm::ObjectTransformation(product.translation(), product.scaling(),
+                                     product.rotation(), product.shearing());
+  }, baseline_checksum);
+
+  EXPECT_NEAR(cached_checksum, baseline_checksum, 1e-6 * std::abs(cached_checksum) + 1e-6);
+  LINFO << "draw traversal: " << cached << "ms per frame with cached matrices, "
+        << baseline << "ms per frame when recomposing (" << baseline / cached << "x).";
+}
@@ -0,0 +1,77 @@
+#include "gtest/gtest.h"
+#include "serializers/jsonserializer.h"
+#include <sstream>
+
+namespace
+{
+
+std::string serialize()
+{
+  std::ostringstream ostream;
+  {
+    omm::JSONSerializer serializer(ostream);
+    serializer.start_array(2, "/objects");
+    for (int i = 0; i < 2; ++i) {
+      const QString object = "/objects/" + QString::number(i);
+      serializer.set_value(i, object + "/id");
+      serializer.set_value(QString("object %1").arg(i), object + "/properties/name/value");
+      serializer.set_value(omm::Vec2f(0.5 * i, -0.5 * i), object + "/properties/pen/color/value");
+    }
+    serializer.end_array();
+    serializer.set_value(true, "/a~0b/c");
+  }
+  return ostream.str();
+}
+
+}  // namespace
+
+TEST(JSONSerializer, cursor)
+{
+  std::istringstream istream(serialize());
+  omm::JSONDeserializer deserializer(istream);
+  ASSERT_EQ(deserializer.array_size("/objects"), 2u);
+
+  // read in order, in reverse order and jump across siblings and depths.
+  for (int i : { 0, 1, 1, 0 }) {
+    const QString object = "/objects/" + QString::number(i);
+    EXPECT_EQ(deserializer.get_int(object + "/id"), i);
+    EXPECT_EQ(deserializer.get_vec2f(object + "/properties/pen/color/value"),
+              omm::Vec2f(0.5 * i, -0.5 * i));
+    EXPECT_EQ(deserializer.get_string(object + "/properties/name/value"),
+              QString("object %1").arg(i));
+  }
+  EXPECT_TRUE(deserializer.get_bool("/a~0b/c"));
+
+  EXPECT_THROW(deserializer.get_int("/objects/2/id"), omm::AbstractDeserializer::DeserializeError);
+  EXPECT_THROW(deserializer.get_int("/objects/0/missing"),
+               omm::AbstractDeserializer::DeserializeError);
+  EXPECT_THROW(deserializer.get_int("/objects/0/id/x"),
+               omm::AbstractDeserializer::DeserializeError);
+  EXPECT_THROW(deserializer.get_string("/objects/0/id"),
+               omm::AbstractDeserializer::DeserializeError);
+  EXPECT_EQ(deserializer.array_size("/missing"), 0u);
+  EXPECT_EQ(deserializer.get_int("/objects/1/id"), 1);
+}
+
+TEST(JSONSerializer, decode)
+{
+  std::istringstream istream(serialize());
+  omm::JSONDeserializer deserializer(istream);
+  deserializer.decode({ "/objects/0", "/objects/1" });
+
+  for (int i : { 1, 0 }) {
+    const QString object = "/objects/" + QString::number(i);
+    EXPECT_EQ(deserializer.get_int(object + "/id"), i);
+    EXPECT_EQ(deserializer.get_vec2f(object + "/properties/pen/color/value"),
+              omm::Vec2f(0.5 * i, -0.5 * i));
+    EXPECT_EQ(deserializer.get_string(object + "/properties/name/value"),
+              QString("object %1").arg(i));
+  }
+  EXPECT_TRUE(deserializer.get_bool("/a~0b/c"));
+  EXPECT_EQ(deserializer.array_size("/objects"), 2u);
+
+  EXPECT_THROW(deserializer.get_int("/objects/0/missing"),
+               omm::AbstractDeserializer::DeserializeError);
+  EXPECT_THROW(deserializer.get_string("/objects/0/id"),
+               omm::AbstractDeserializer::DeserializeError);
+}
@@ -0,0 +1,119 @@
+#include "gtest/gtest.h"
+#include "renderers/pngwriter.h"
+#include <QFile>
+#include <QTemporaryDir>
+#include <cstdlib>
+
+namespace
+{
+
+constexpr int WIDTH = 17;
+constexpr int HEIGHT = 23;
+
+/**
+ * @brief straight_image returns a semi-transparent image with non-premultiplied alpha.
+ */
+QImage straight_image()
+{
+  QImage image(WIDTH, HEIGHT, QImage::Format_ARGB32);
+  for (int y = 0; y < HEIGHT; ++y) {
+    for (int x = 0; x < WIDTH; ++x) {
+      image.setPixel(x, y, qRgba(10 * x, 200, 10 * y, 64 + 8 * y));
+    }
+  }
+  return image;
+}
+
+bool write(const QString& filename, const QImage& image, const std::vector<int>& band_heights)
+{
+  omm::PngWriter writer(filename, QSize(WIDTH, HEIGHT));
+  int y = 0;
+  for (const int height : band_heights) {
+    if (!writer.write(image.copy(0, y, image.width(), height))) {
+      return false;
+    }
+    y += height;
+  }
+  return writer.finish();
+}
+
+}  // namespace
+
+TEST(PngWriter, bands)
+{
+  QTemporaryDir dir;
+  ASSERT_TRUE(dir.isValid());
+  const QString filename = dir.filePath("image.png");
+  const QImage straight = straight_image();
+  const QImage premultiplied = straight.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+
+  ASSERT_TRUE(write(filename, premultiplied, { 3, 7, HEIGHT - 10 }));
+  const QImage image = QImage(filename).convertToFormat(QImage::Format_ARGB32);
+  ASSERT_EQ(image.size(), QSize(WIDTH, HEIGHT));
+
+  // the file stores straight alpha, the premultiplied input has been converted exactly once.
+  EXPECT_EQ(image, premultiplied.convertToFormat(QImage::Format_ARGB32));
+  for (int y = 0; y < HEIGHT; ++y) {
+    for (int x = 0; x < WIDTH; ++x) {
+      const QRgb expected = straight.pixel(x, y);
+      const QRgb actual = image.pixel(x, y);
+      // premultiplication loses up to 255 / alpha levels of precision.
+      const int tolerance = 255 / qAlpha(expected) + 1;
+      EXPECT_EQ(qAlpha(actual), qAlpha(expected));
+      EXPECT_LE(std::abs(qRed(actual) - qRed(expected)), tolerance);
+      EXPECT_LE(std::abs(qGreen(actual) - qGreen(expected)), tolerance);
+      EXPECT_LE(std::abs(qBlue(actual) - qBlue(expected)), tolerance);
+    }
+  }
+}
+
+TEST(PngWriter, wrong_width)
+{
+  QTemporaryDir dir;
+  ASSERT_TRUE(dir.isValid());
+  const QString filename = dir.filePath("image.png");
+  {
+    omm::PngWriter writer(filename, QSize(WIDTH, HEIGHT));
+    EXPECT_FALSE(writer.write(QImage(WIDTH - 1, HEIGHT, QImage::Format_ARGB32_Premultiplied)));
+
+    // the writer is broken from now on.
+    EXPECT_FALSE(writer.write(QImage(WIDTH, HEIGHT, QImage::Format_ARGB32_Premultiplied)));
+    EXPECT_FALSE(writer.finish());
+  }
+  EXPECT_FALSE(QFile::exists(filename));
+}
+
+TEST(PngWriter, too_many_rows)
+{
+  QTemporaryDir dir;
+  ASSERT_TRUE(dir.isValid());
+  const QString filename = dir.filePath("image.png");
+  {
+    omm::PngWriter writer(filename, QSize(WIDTH, HEIGHT));
+    EXPECT_TRUE(writer.write(QImage(WIDTH, HEIGHT - 1, QImage::Format_ARGB32_Premultiplied)));
+    EXPECT_FALSE(writer.write(QImage(WIDTH, 2, QImage::Format_ARGB32_Premultiplied)));
+    EXPECT_FALSE(writer.finish());
+  }
+  EXPECT_FALSE(QFile::exists(filename));
+}
+
+TEST(PngWriter, missing_rows)
+{
+  QTemporaryDir dir;
+  ASSERT_TRUE(dir.isValid());
+  const QString filename = dir.filePath("image.png");
+  {
+    omm::PngWriter writer(filename, QSize(WIDTH, HEIGHT));
+    EXPECT_TRUE(writer.write(QImage(WIDTH, HEIGHT - 1, QImage::Format_ARGB32_Premultiplied)));
+    EXPECT_TRUE(QFile::exists(filename));
+    EXPECT_FALSE(writer.finish());
+  }
+  EXPECT_FALSE(QFile::exists(filename));
+
+  // a writer which is never finished removes the file, too.
+  {
+    omm::PngWriter writer(filename, QSize(WIDTH, HEIGHT));
+    EXPECT_TRUE(writer.write(QImage(WIDTH, HEIGHT, QImage::Format_ARGB32_Premultiplied)));
+  }
+  EXPECT_FALSE(QFile::exists(filename));
+}
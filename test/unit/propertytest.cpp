@@ -1,6 +1,28 @@
+#include "aspects/propertyowner.h"
+#include "properties/floatproperty.h"
 #include "properties/property.h"
+#include "properties/propertykey.h"
 #include <gtest/gtest.h>
 
+namespace
+{
+
+class Owner : public omm::PropertyOwner<omm::Kind::None>
+{
+public:
+  explicit Owner(const std::vector<QString>& keys) : PropertyOwner(nullptr)
+  {
+    for (const QString& key : keys) {
+      create_property<omm::FloatProperty>(key, 0.0);
+    }
+  }
+
+  QString type() const override { return "Owner"; }
+  omm::Flag flags() const override { return omm::Flag::None; }
+};
+
+}  // namespace
+
 TEST(Property, ReferenceFilter)
 {
   using namespace omm;
@@ -20,3 +42,61 @@ TEST(Property, ReferenceFilter)
   EXPECT_FALSE(any_object.accepts(Kind::Tag, Flag::HasPython | Flag::Convertible));
   EXPECT_FALSE(any_object.accepts(Kind::Style, Flag::Convertible));
 }
+
+TEST(Property, InternedKeys)
+{
+  using namespace omm;
+  const PropertyKey position("position");
+  EXPECT_EQ(position.string(), QString("position"));
+  EXPECT_EQ(position.id(), PropertyKey::intern("position"));
+  EXPECT_EQ(PropertyKey::intern(QString("posi") + "tion"), position.id());
+  EXPECT_NE(PropertyKey::intern("scale"), position.id());
+}
+
+TEST(Property, OwnerLookupByKey)
+{
+  using namespace omm;
+  Owner abc({ "a", "b", "c" });
+  Owner ca({ "c", "a" });
+  const PropertyKey c("c");
+  const PropertyKey missing("missing");
+
+  // the first lookup scans, the second one hits the remembered slot.
+  EXPECT_EQ(abc.property(c), abc.property(QString("c")));
+  EXPECT_EQ(abc.property(c), abc.property(QString("c")));
+
+  // the slot remembered for `abc` is wrong for `ca`, the lookup falls back to a scan.
+  EXPECT_EQ(ca.property(c), ca.property(QString("c")));
+  EXPECT_EQ(abc.property(c), abc.property(QString("c")));
+
+  EXPECT_EQ(abc.property(missing), nullptr);
+}
+
+TEST(Property, OwnerLookupAfterExtract)
+{
+  using namespace omm;
+  Owner owner({ "a", "b", "c" });
+  const PropertyKey a("a");
+  const PropertyKey c("c");
+  ASSERT_NE(owner.property(c), nullptr);  // remember the slot of `c`.
+
+  const auto extracted = owner.extract_property("a");
+  ASSERT_NE(extracted, nullptr);
+  EXPECT_EQ(owner.property(a), nullptr);
+  EXPECT_EQ(owner.property(c), owner.property(QString("c")));
+  EXPECT_NE(owner.property(c), extracted.get());
+}
+
+TEST(Property, OwnerValueReference)
+{
+  using namespace omm;
+  Owner owner({ "x" });
+  const PropertyKey x("x");
+  static_assert(std::is_same_v<decltype(owner.property_value<double>(x)), const double&>);
+
+  const double& value = owner.property_value<double>(x);
+  const auto& property = static_cast<const FloatProperty&>(*owner.property(x));
+  EXPECT_EQ(&value, &property.value());
+  owner.property(x)->set(2.0);
+  EXPECT_EQ(value, 2.0);
+}
@@ -0,0 +1,218 @@
+#include "gtest/gtest.h"
+#include "animation/track.h"
+#include "aspects/abstractpropertyowner.h"
+#include "nodesystem/nodemodel.h"
+#include "objects/object.h"
+#include "properties/referenceproperty.h"
+#include "scene/sceneindex.h"
+#include "serializers/jsonserializer.h"
+#include "tags/nodestag.h"
+#include "tags/styletag.h"
+#include <sstream>
+
+namespace
+{
+
+using Pointer = omm::Serializable::Pointer;
+using APO = omm::AbstractPropertyOwner;
+
+Pointer child(const Pointer& pointer, std::size_t i)
+{
+  return omm::Serializable::make_pointer(pointer, omm::Object::CHILDREN_POINTER, i);
+}
+
+Pointer property(const Pointer& owner, std::size_t i)
+{
+  return omm::Serializable::make_pointer(owner, APO::PROPERTIES_POINTER, i);
+}
+
+Pointer tag(const Pointer& object, std::size_t i)
+{
+  return omm::Serializable::make_pointer(object, omm::Object::TAGS_POINTER, i);
+}
+
+void set_id(omm::JSONSerializer& serializer, const Pointer& owner, std::size_t id)
+{
+  serializer.set_value(id, omm::Serializable::make_pointer(owner, APO::ID_POINTER));
+}
+
+void set_object(omm::JSONSerializer& serializer, const Pointer& object, std::size_t id,
+                const QString& name)
+{
+  using omm::Serializable;
+  set_id(serializer, object, id);
+  serializer.set_value(QString("Empty"),
+                       Serializable::make_pointer(object, omm::Object::TYPE_POINTER));
+  const Pointer name_pointer = property(object, 0);
+  serializer.set_value(APO::NAME_PROPERTY_KEY,
+                       Serializable::make_pointer(name_pointer, APO::PROPERTY_KEY_POINTER));
+  serializer.set_value(QString("StringProperty"),
+                       Serializable::make_pointer(name_pointer, APO::PROPERTY_TYPE_POINTER));
+  serializer.set_value(name, Serializable::make_pointer(name_pointer,
+                                                        omm::TypedPropertyDetail::VALUE_POINTER));
+}
+
+void set_reference(omm::JSONSerializer& serializer, const Pointer& property_pointer,
+                   std::size_t id, const std::vector<std::size_t>& knots = {})
+{
+  using omm::Serializable;
+  serializer.set_value(QString("reference"),
+                       Serializable::make_pointer(property_pointer, APO::PROPERTY_KEY_POINTER));
+  serializer.set_value(omm::ReferenceProperty::TYPE(),
+                       Serializable::make_pointer(property_pointer, APO::PROPERTY_TYPE_POINTER));
+  serializer.set_value(id, Serializable::make_pointer(property_pointer,
+                                                      omm::TypedPropertyDetail::VALUE_POINTER));
+  const bool is_animated = !knots.empty();
+  serializer.set_value(is_animated, Serializable::make_pointer(property_pointer,
+                                                               omm::Property::IS_ANIMATED_POINTER));
+  for (std::size_t k = 0; k < knots.size(); ++k) {
+    serializer.set_value(knots.at(k), Serializable::make_pointer(property_pointer,
+                                                                 omm::Property::TRACK_POINTER,
+                                                                 omm::Track::KNOTS_KEY, k,
+                                                                 omm::Track::VALUE_KEY));
+  }
+}
+
+/**
+ * @brief serialize writes the outline of a scene:
+ *  /root
+ *    /parent (10)                    /parent/child (11)
+ *    /unrelated (20)                 /unrelated/grandchild (21)
+ *    /referrer (30)                  references /unrelated
+ *    /animated (40)                  references nothing, animated to reference /keyframe
+ *    /keyframe (50)
+ *    /tag owner (60)                 has a StyleTag (61)
+ *    /tag referrer (70)              references the tag of /tag owner
+ *    /nodes (80)                     has a NodesTag (81) with a node referencing /node target
+ *    /node target (90)               references /lonely
+ *    /lonely (100)
+ */
+std::string serialize()
+{
+  std::ostringstream ostream;
+  {
+    omm::JSONSerializer serializer(ostream);
+    const Pointer root = omm::Serializable::make_pointer("root");
+    set_id(serializer, root, 1);
+
+    set_object(serializer, child(root, 0), 10, "parent");
+    set_object(serializer, child(child(root, 0), 0), 11, "child");
+    set_object(serializer, child(root, 1), 20, "unrelated");
+    set_object(serializer, child(child(root, 1), 0), 21, "grandchild");
+    set_object(serializer, child(root, 2), 30, "referrer");
+    set_reference(serializer, property(child(root, 2), 1), 20);
+    set_object(serializer, child(root, 3), 40, "animated");
+    set_reference(serializer, property(child(root, 3), 1), 0, { 50, 0 });
+    set_object(serializer, child(root, 4), 50, "keyframe");
+    set_object(serializer, child(root, 5), 60, "tag owner");
+    serializer.set_value(QString(omm::StyleTag::TYPE),
+                         omm::Serializable::make_pointer(tag(child(root, 5), 0),
+                                                         omm::Object::TYPE_POINTER));
+    set_id(serializer, tag(child(root, 5), 0), 61);
+    set_object(serializer, child(root, 6), 70, "tag referrer");
+    set_reference(serializer, property(child(root, 6), 1), 61);
+    set_object(serializer, child(root, 7), 80, "nodes");
+    const Pointer nodes_tag = tag(child(root, 7), 0);
+    serializer.set_value(QString(omm::NodesTag::TYPE),
+                         omm::Serializable::make_pointer(nodes_tag, omm::Object::TYPE_POINTER));
+    set_id(serializer, nodes_tag, 81);
+    const Pointer node = omm::Serializable::make_pointer(nodes_tag, omm::NodesTag::NODES_POINTER,
+                                                         omm::NodeModel::NODES_POINTER, 0);
+    set_reference(serializer, property(node, 0), 90);
+    set_object(serializer, child(root, 8), 90, "node target");
+    set_reference(serializer, property(child(root, 8), 1), 100);
+    set_object(serializer, child(root, 9), 100, "lonely");
+  }
+  return ostream.str();
+}
+
+std::set<Pointer> closure(const omm::SceneIndex& index, const std::set<QString>& names)
+{
+  return index.closure([&names](const omm::SceneIndex::Entry& entry, const QString&) {
+    return names.count(entry.name) > 0;
+  });
+}
+
+}  // namespace
+
+TEST(SceneIndex, entries)
+{
+  std::istringstream istream(serialize());
+  omm::JSONDeserializer deserializer(istream);
+  const omm::SceneIndex index(deserializer, "root");
+
+  const auto& entries = index.entries();
+  ASSERT_EQ(entries.size(), 13u);
+  EXPECT_EQ(entries.at(0).pointer, "/root");
+  EXPECT_EQ(entries.at(0).children.size(), 10u);
+  EXPECT_EQ(entries.at(1).pointer, "/root/children/0");
+  EXPECT_EQ(entries.at(2).pointer, "/root/children/0/children/0");
+  EXPECT_EQ(index.tree_path(2), "/parent/child");
+  EXPECT_EQ(*entries.at(2).parent, 1u);
+  EXPECT_EQ(entries.at(5).references, std::set<std::size_t>({ 20 }));
+  EXPECT_EQ(entries.at(6).references, std::set<std::size_t>({ 0, 50 }));
+  EXPECT_EQ(entries.at(8).tag_types, QStringList({ omm::StyleTag::TYPE }));
+  EXPECT_EQ(entries.at(10).references, std::set<std::size_t>({ 90 }));
+}
+
+TEST(SceneIndex, closure)
+{
+  std::istringstream istream(serialize());
+  omm::JSONDeserializer deserializer(istream);
+  const omm::SceneIndex index(deserializer, "root");
+  using Pointers = std::set<Pointer>;
+
+  // the root is always required.
+  EXPECT_EQ(closure(index, {}), Pointers({ "/root" }));
+
+  // descendants and ancestors.
+  EXPECT_EQ(closure(index, { "parent" }),
+            Pointers({ "/root", "/root/children/0", "/root/children/0/children/0" }));
+  EXPECT_EQ(index.closure([](const auto&, const QString& path) { return path == "/parent/child"; }),
+            Pointers({ "/root", "/root/children/0", "/root/children/0/children/0" }));
+
+  // a reference pulls in the whole referenced subtree.
+  EXPECT_EQ(closure(index, { "referrer" }),
+            Pointers({ "/root", "/root/children/1", "/root/children/1/children/0",
+                       "/root/children/2" }));
+
+  // the knots of an animated reference are references, too.
+  EXPECT_EQ(closure(index, { "animated" }),
+            Pointers({ "/root", "/root/children/3", "/root/children/4" }));
+
+  // a reference to a tag pulls in the owner of the tag.
+  EXPECT_EQ(closure(index, { "tag referrer" }),
+            Pointers({ "/root", "/root/children/5", "/root/children/6" }));
+
+  // the nodes of a NodesTag reference objects, references are followed recursively.
+  EXPECT_EQ(closure(index, { "nodes" }),
+            Pointers({ "/root", "/root/children/7", "/root/children/8", "/root/children/9" }));
+
+  // references point from the referrer to the referenced object only.
+  EXPECT_EQ(closure(index, { "lonely", "unrelated" }),
+            Pointers({ "/root", "/root/children/1", "/root/children/1/children/0",
+                       "/root/children/9" }));
+}
+
+TEST(SceneIndex, restrict_objects)
+{
+  std::istringstream istream(serialize());
+  omm::JSONDeserializer deserializer(istream);
+
+  // `Object::deserialize` deserializes the `accepted_objects` of its children array.
+  EXPECT_EQ(deserializer.accepted_objects("/root/children").size(), 10u);
+
+  deserializer.restrict_objects(omm::SceneIndex(deserializer, "root").closure(
+      [](const omm::SceneIndex::Entry& entry, const QString&) {
+    return entry.name == "referrer";
+  }));
+  using Pointers = std::vector<Pointer>;
+  EXPECT_EQ(deserializer.accepted_objects("/root/children"),
+            Pointers({ "/root/children/1", "/root/children/2" }));
+  EXPECT_EQ(deserializer.accepted_objects("/root/children/1/children"),
+            Pointers({ "/root/children/1/children/0" }));
+  EXPECT_TRUE(deserializer.accepted_objects("/root/children/0/children").empty());
+  EXPECT_TRUE(deserializer.accepted_objects("/root/children/2/children").empty());
+  EXPECT_FALSE(deserializer.accepts_object("/root/children/0"));
+  EXPECT_TRUE(deserializer.accepts_object("/root/children/2"));
+}
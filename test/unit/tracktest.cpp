@@ -0,0 +1,91 @@
+#include "gtest/gtest.h"
+#include "animation/track.h"
+#include "properties/floatproperty.h"
+#include <algorithm>
+#include <random>
+
+namespace
+{
+
+void insert_linear_knots(omm::Track& track, int n, int step)
+{
+  // value = 2 * frame
+  for (int i = 0; i < n; ++i) {
+    const int frame = i * step;
+    track.insert_knot(frame, std::make_unique<omm::Track::Knot>(2.0 * frame));
+  }
+}
+
+}  // namespace
+
+TEST(TrackTest, interpolate_linear)
+{
+  omm::FloatProperty property;
+  omm::Track track(property);
+  track.set_interpolation(omm::Track::Interpolation::Linear);
+  insert_linear_knots(track, 5, 10);
+
+  EXPECT_DOUBLE_EQ(track.interpolate(-5.0, 0), 0.0);
+  EXPECT_DOUBLE_EQ(track.interpolate(0.0, 0), 0.0);
+  EXPECT_DOUBLE_EQ(track.interpolate(5.0, 0), 10.0);
+  EXPECT_DOUBLE_EQ(track.interpolate(10.0, 0), 20.0);
+  EXPECT_DOUBLE_EQ(track.interpolate(12.5, 0), 25.0);
+  EXPECT_DOUBLE_EQ(track.interpolate(40.0, 0), 80.0);
+  EXPECT_DOUBLE_EQ(track.interpolate(100.0, 0), 80.0);
+}
+
+TEST(TrackTest, interpolate_step)
+{
+  omm::FloatProperty property;
+  omm::Track track(property);
+  track.set_interpolation(omm::Track::Interpolation::Step);
+  insert_linear_knots(track, 3, 10);
+
+  EXPECT_DOUBLE_EQ(track.interpolate(9.9, 0), 0.0);
+  EXPECT_DOUBLE_EQ(track.interpolate(10.0, 0), 20.0);
+  EXPECT_DOUBLE_EQ(track.interpolate(15.0, 0), 20.0);
+}
+
+TEST(TrackTest, interpolate_in_any_order)
+{
+  omm::FloatProperty property;
+  omm::Track track(property);
+  track.set_interpolation(omm::Track::Interpolation::Linear);
+  insert_linear_knots(track, 10000, 3);
+
+  const auto check = [&track](double frame) {
+    const double expected = 2.0 * std::clamp(frame, 0.0, 3.0 * 9999);
+    EXPECT_NEAR(track.interpolate(frame, 0), expected, 1e-9);
+    EXPECT_NEAR(std::get<double>(track.interpolate(frame)), expected, 1e-9);
+  };
+
+  for (double frame = -10.0; frame < 30010.0; frame += 0.7) {
+    check(frame);
+  }
+  for (double frame = 30010.0; frame > -10.0; frame -= 1.3) {
+    check(frame);
+  }
+
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<double> dist(-10.0, 30010.0);
+  for (std::size_t i = 0; i < 1000; ++i) {
+    check(dist(rng));
+  }
+}
+
+TEST(TrackTest, interpolate_after_modification)
+{
+  omm::FloatProperty property;
+  omm::Track track(property);
+  track.set_interpolation(omm::Track::Interpolation::Linear);
+  insert_linear_knots(track, 3, 10);
+
+  EXPECT_DOUBLE_EQ(track.interpolate(5.0, 0), 10.0);
+  track.insert_knot(5, std::make_unique<omm::Track::Knot>(0.0));
+  EXPECT_DOUBLE_EQ(track.interpolate(5.0, 0), 0.0);
+  EXPECT_DOUBLE_EQ(track.interpolate(7.5, 0), 10.0);
+  track.remove_knot(5);
+  EXPECT_DOUBLE_EQ(track.interpolate(7.5, 0), 15.0);
+  track.move_knot(20, 30);
+  EXPECT_DOUBLE_EQ(track.interpolate(20.0, 0), 30.0);
+}